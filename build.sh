@@ -51,7 +51,7 @@ function buildAndroid()
 
   cmake -E make_directory build-$1
   # 24 required for vulkan https://github.com/nihui/ncnn-android-yolov5/issues/10#issuecomment-800374356
-  cmake -E chdir build-$1 cmake .. -D ANDROID=ON -D ANDROID_PLATFORM=24 -D ANDROID_ABI=$1 -D BUILD_DEMOS=$DEMO -D RELEASE=$RELEASE -D TEST_SUITE=$TEST -D SYNTAX_ONLY=$SYNTAX -D SANITISE=$SANITISE -D CMAKE_TOOLCHAIN_FILE=$TOOL_CHAIN && make -j 4 -C build-$1
+  cmake -E chdir build-$1 cmake .. -D ANDROID=ON -D ANDROID_PLATFORM=24 -D ANDROID_ABI=$1 -D BUILD_DEMOS=$DEMO -D RELEASE=$RELEASE -D TEST_SUITE=$TEST -D SYNTAX_ONLY=$SYNTAX -D SANITISE=$SANITISE -D SINGLE_PRECISION=$SINGLE -D CMAKE_TOOLCHAIN_FILE=$TOOL_CHAIN && make -j 4 -C build-$1
   STATUS=$?
   if [[ $MERGE -eq 1 ]]
   then
@@ -77,6 +77,7 @@ STANDALONE=0
 CLEAN=1
 PROFILE=0
 MERGE=1
+SINGLE=0
 
 while [[ $# -gt 0 ]]; do
   case $1 in
@@ -138,6 +139,10 @@ while [[ $# -gt 0 ]]; do
       PROFILE=1
       shift
       ;;
+    --single)
+      SINGLE=1
+      shift
+      ;;
     -*|--*)
       echo "Unknown option $1"
       exit 1
@@ -172,7 +177,7 @@ then
     ln -s "$VK_SDK/Include" "$VK_SDK/Windows/Include"
     ln -s "$VK_SDK/Windows/Include" "$VK_SDK/Windows/include"
     cd build
-    cmake .. -D WINDOWS=ON -D STANDALONE=$STANDALONE -D BUILD_DEMOS=$DEMO -D RELEASE=$RELEASE -D BENCHMARK=$BENCHMARK -D TEST_SUITE=$TEST -D SYNTAX_ONLY=$SYNTAX -D SANITISE=$SANITISE -D CMAKE_TOOLCHAIN_FILE=./windows.cmake && make -j 4
+    cmake .. -D WINDOWS=ON -D STANDALONE=$STANDALONE -D BUILD_DEMOS=$DEMO -D RELEASE=$RELEASE -D BENCHMARK=$BENCHMARK -D TEST_SUITE=$TEST -D SYNTAX_ONLY=$SYNTAX -D SANITISE=$SANITISE -D SINGLE_PRECISION=$SINGLE -D CMAKE_TOOLCHAIN_FILE=./windows.cmake && make -j 4
     STATUS=$?
     cd ..
 
@@ -208,7 +213,7 @@ then
   elif [[ $OSX -eq 0 ]];
   then
     cd build
-    cmake .. -D OSX=ON -D STANDALONE=$STANDALONE -D BUILD_DEMOS=$DEMO -D RELEASE=$RELEASE -D BENCHMARK=$BENCHMARK -D TEST_SUITE=$TEST -D SYNTAX_ONLY=$SYNTAX -D SANITISE=$SANITISE -D CMAKE_TOOLCHAIN_FILE=./osx.cmake && make -j 4
+    cmake .. -D OSX=ON -D STANDALONE=$STANDALONE -D BUILD_DEMOS=$DEMO -D RELEASE=$RELEASE -D BENCHMARK=$BENCHMARK -D TEST_SUITE=$TEST -D SYNTAX_ONLY=$SYNTAX -D SANITISE=$SANITISE -D SINGLE_PRECISION=$SINGLE -D CMAKE_TOOLCHAIN_FILE=./osx.cmake && make -j 4
     STATUS=$?
     cd ..
   elif [[ ! -z "$ANDROID_NDK" ]]
@@ -229,7 +234,7 @@ then
 
   else
     cd build
-    cmake -D BUILD_DEMOS=$DEMO -D PROFILE=$PROFILE -D STANDALONE=$STANDALONE -D RELEASE=$RELEASE -D BENCHMARK=$BENCHMARK -D TEST_SUITE=$TEST -D SANITISE=$SANITISE -D SYNTAX_ONLY=$SYNTAX .. && make -j 4
+    cmake -D BUILD_DEMOS=$DEMO -D PROFILE=$PROFILE -D STANDALONE=$STANDALONE -D RELEASE=$RELEASE -D BENCHMARK=$BENCHMARK -D TEST_SUITE=$TEST -D SANITISE=$SANITISE -D SINGLE_PRECISION=$SINGLE -D SYNTAX_ONLY=$SYNTAX .. && make -j 4
     STATUS=$?
     cd ..
   fi
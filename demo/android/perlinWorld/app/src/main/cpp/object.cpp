@@ -51,10 +51,10 @@ extern "C"
                     )
             );
 
-            std::vector<std::shared_ptr<CollisionPrimitive>> mesh;
+            std::vector<CollisionPrimitive> mesh;
             mesh.push_back
                     (
-                            std::make_shared<CollisionPrimitive>
+                            CollisionPrimitive
                                     (
                                             0.0,
                                             0.0,
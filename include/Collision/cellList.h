@@ -5,6 +5,7 @@
 #include <Collision/springDashpotResolver.h>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <World/tileWorld.h>
 #include <World/marchingWorld.h>
@@ -20,10 +21,12 @@ namespace Hop::System::Physics
     using Hop::World::TileWorld;
     using Hop::World::MarchingWorld;
 
-    const uint64_t MAX_PARTICLES = 100000;
-    const uint64_t MAX_PARTICLES_PER_CELL = 64;
-    const uint64_t NULL_INDEX = MAX_PARTICLES+1;
-
+    /*
+        Uniform grid broad phase. Each step the primitives are
+        counting sorted by cell into compact (CSR) arrays, so
+        memory is proportional to the primitive count and no
+        cell or global capacity is imposed.
+    */
     class CellList : public CollisionDetector 
     {
     public:
@@ -34,34 +37,117 @@ namespace Hop::System::Physics
 
         uint64_t getRootNCells(){ return rootNCells; }
 
-    private:
+        /*
+            Bin the non ghost objects' primitives in two passes,
+            count per cell then scatter, O(primitives + cells).
+            Objects are read at the view's indices, in its order.
+        */
+        void populate
+        (      
+            ComponentArray<cCollideable> & dataC,
+            ComponentArray<cPhysics> & dataP,
+            CollideableView & objects
+        );
+
+        // primitives binned by the last populate
+        uint64_t size() const { return id.size(); }
+
+        uint64_t cellSize(uint64_t c) const { return cellStart[c+1]-cellStart[c]; }
+
+        // object pairs with overlapping bounds found by the last populate
+        uint64_t candidatePairs() const { return objectPairs.size(); }
+
+    protected:
 
         uint64_t rootNCells, nCells; // rootNCells x rootNCells grid
 
         double dx, dy;
 
-        std::unique_ptr<uint64_t[]> cells;
-        std::unique_ptr<uint64_t[]> lastElementInCell;
-        
-        std::unique_ptr<bool[]> notEmpty;
-        uint64_t countNotEmpty;
+        // primitive k is vertex id[k].second of object id[k].first
+        std::vector<std::pair<Id,uint64_t>> id;
+        std::vector<uint64_t> cell;
+
+        // and object[k] indexes the binned objects, objectIds
+        std::vector<uint64_t> object;
+        std::vector<Id> objectIds;
+
+        // binned objects' dense component indices, so pair tests
+        //  walk the component arrays without hashing ids
+        std::vector<uint64_t> objectIndexC, objectIndexP;
+
+        /*
+            Object level broad phase. Each binned object is bounded
+            by its mesh's circle (CollisionMesh::getRadius), objects
+            whose circles come within margin of another's are found
+            by a sweep along x, and only their primitives are binned.
+            Soft meshes collide with themselves so are always binned.
+        */
+        double margin = 0.0;
+        std::vector<double> boundsX, boundsY, boundsR;
+        std::vector<uint64_t> sweep;
+        std::vector<uint8_t> candidate;
+        std::vector<std::pair<uint64_t,uint64_t>> objectPairs;
+
+        void objectBroadPhase();
+
+        bool boundsOverlap(uint64_t i, uint64_t j) const
+        {
+            if (i == j)
+            {
+                return true;
+            }
+
+            double rx = boundsX[j]-boundsX[i];
+            double ry = boundsY[j]-boundsY[i];
+            double rc = boundsR[i]+boundsR[j]+margin;
+
+            return rx*rx+ry*ry <= rc*rc;
+        }
 
-        std::unique_ptr<std::pair<Id,uint64_t>[]> id;
-        uint64_t lastElement;
+        // cell c holds cellIndex[cellStart[c]] ... cellIndex[cellStart[c+1]-1]
+        std::vector<uint64_t> cellStart;
+        std::vector<uint64_t> cellFill;
+        std::vector<uint64_t> cellIndex;
 
         uint64_t hash(double x, double y)
         {
             return std::floor((x-limX.first)/dx)*rootNCells+std::floor((y-limY.first)/dy);
         }
 
-        void clear(bool full = false);
+        void allocate();
 
-        void populate
-        (      
-            ComponentArray<cCollideable> & dataC,
-            ComponentArray<cPhysics> & dataP,
-            std::set<Id> objects
-        );
+        // regrid the same limits as rootNCells x rootNCells
+        void setRootNCells(uint64_t n);
+
+        // one is asleep and neither can move, so there is nothing to resolve
+        static bool dormant(const cPhysics & a, const cPhysics & b)
+        {
+            return (a.isAsleep || b.isAsleep) && 
+                   (a.isAsleep || !a.isMoveable) && 
+                   (b.isAsleep || !b.isMoveable);
+        }
+
+    private:
+
+        // the non empty cells, in order
+        std::vector<uint64_t> occupiedCells;
+
+        /*
+            Finding contacts writes nothing shared, so each worker
+            takes a run of occupiedCells into its own accumulator
+            (without workers, one takes them all). Joined in worker
+            order the contacts and collisions are as a serial step
+            finds them, whatever the worker count, and are evaluated
+            and applied as one. The world pass likewise takes a run
+            of the objects per worker.
+        */
+        struct WorkerAccumulator
+        {
+            ContactBuffer contacts;
+            CollisionLog collided;
+        };
+
+        std::vector<WorkerAccumulator> accumulators;
 
         void cellCollisions(
             uint64_t a1,
@@ -70,36 +156,39 @@ namespace Hop::System::Physics
             uint64_t b2,
             ComponentArray<cCollideable> & dataC,
             ComponentArray<cPhysics> & dataP,
-            CollisionResolver * resolver
+            CollisionResolver * resolver,
+            WorkerAccumulator & accumulator
         );
 
-        void cellCollisionsThreaded(
-            uint64_t a1,
-            uint64_t b1,
-            uint64_t a2,
-            uint64_t b2,
-            cCollideable * dataC,
-            dense_hash_map<Id,uint64_t> & idToIndexC,
-            cPhysics * dataP,
-            dense_hash_map<Id,uint64_t> & idToIndexP,
-            CollisionResolver * resolver
+        // cells occupiedCells[begin, end) into accumulators[worker]
+        void handleOccupiedCells(
+            ComponentArray<cCollideable> & dataC,
+            ComponentArray<cPhysics> & dataP,
+            CollisionResolver * resolver,
+            uint64_t begin,
+            uint64_t end,
+            unsigned worker
         );
 
-        void handleObjectObjectCollisionsThreaded(
-            cCollideable * dataC,
-            dense_hash_map<Id,uint64_t> & idToIndexC,
-            cPhysics * dataP,
-            dense_hash_map<Id,uint64_t> & idToIndexP,
+        // rows [begin, end) of ids into accumulators[worker]
+        void handleWorldObjects(
+            ComponentArray<cCollideable> & dataC,
+            ComponentArray<cPhysics> & dataP,
             CollisionResolver * resolver,
-            std::pair<unsigned,unsigned> * jobs,
-            unsigned njobs
+            AbstractWorld * world,
+            const std::vector<Id> & ids,
+            const std::vector<uint64_t> & indexC,
+            const std::vector<uint64_t> & indexP,
+            uint64_t begin,
+            uint64_t end,
+            unsigned worker
         );
 
         void handleObjectObjectCollisions(
             ComponentArray<cCollideable> & dataC,
             ComponentArray<cPhysics> & dataP,
             CollisionResolver * resolver,
-            std::set<Id> objects,
+            CollideableView & objects,
             ThreadPool * workers = nullptr
         );
 
@@ -108,7 +197,7 @@ namespace Hop::System::Physics
             ComponentArray<cPhysics> & dataP,
             CollisionResolver * resolver,
             AbstractWorld * world,
-            std::set<Id> objects,
+            CollideableView & objects,
             ThreadPool * workers = nullptr
         );
 
@@ -1,32 +1,39 @@
 #ifndef COLLISIONDETECTOR_H
 #define COLLISIONDETECTOR_H
 
-#include <set>
-
 #include <jThread/jThread.h>
 
 #include <Component/componentArray.h>
+#include <Component/componentView.h>
 #include <Component/cPhysics.h>
 #include <Component/cCollideable.h>
 
 #include <Collision/collisionResolver.h>
+#include <Collision/collisionLog.h>
 #include <Object/id.h>
 
 #include <World/world.h>
 #include <Util/util.h>
+#include <Util/timings.h>
 
 namespace Hop::System::Physics
 {
 
     using Hop::Util::tupled;
+    using Hop::Util::PhysicsTimings;
+    using Hop::Util::PhaseClock;
     using Hop::World::AbstractWorld;
 
     using Hop::Object::Id;
 
     using Hop::Object::Component::ComponentArray;
+    using Hop::Object::Component::ComponentView;
     using Hop::Object::Component::cCollideable;
     using Hop::Object::Component::cPhysics;
 
+    // the objects that collide, with their dense indices
+    typedef ComponentView<cPhysics, cCollideable> CollideableView;
+
     using jThread::ThreadPool;
 
     class CollisionDetector 
@@ -48,7 +55,7 @@ namespace Hop::System::Physics
             ComponentArray<cCollideable> & dataC,
             ComponentArray<cPhysics> & dataP,
             CollisionResolver * resolver,
-            std::set<Id>,
+            CollideableView & objects,
             ThreadPool * workers = nullptr
         ) = 0;
 
@@ -57,7 +64,7 @@ namespace Hop::System::Physics
             ComponentArray<cPhysics> & dataP,
             CollisionResolver * resolver,
             AbstractWorld * world,
-            std::set<Id> objects,
+            CollideableView & objects,
             ThreadPool * workers = nullptr
         ) = 0;
 
@@ -73,24 +80,35 @@ namespace Hop::System::Physics
             );
         }
 
-        struct CollisionType 
-        { 
-            CollisionType(Id i, bool w)
-            : with(i), world(w)
-            {}
-            Id with;
-            bool world;
-        };
+        using CollisionType = Hop::System::Physics::CollisionType;
+
+        virtual std::pair<CollisionLog::const_iterator, CollisionLog::const_iterator> objectCollisions(Id & id) { return collided.equal_range(id); }
+        virtual bool objectHasCollided(Id & id) { return collided.contains(id); }
+
+        // every collision of the last step, each object object pair recorded both ways
+        const CollisionLog & getCollisions() const { return collided; }
 
-        virtual std::pair<std::multimap<Id, CollisionType>::iterator, std::multimap<Id, CollisionType>::iterator> objectCollisions(Id & id) { return collided.equal_range(id); }
-        virtual bool objectHasCollided(Id & id) { return collided.find(id) != collided.end(); }
+        /*
+            The object object contacts of the last step, with the
+            forces they applied.
+        */
+        const ContactBuffer & getContacts() const { return contacts; }
+
+        // broad, narrow and world phase times (BENCHMARK builds)
+        const PhysicsTimings & getTimings() const { return timings; }
+        void resetTimings() { timings = PhysicsTimings(); }
 
     protected:
 
         tupled limX, limY;
         double lX, lY;
 
-        std::multimap<Id, CollisionType> collided;
+        CollisionLog collided;
+
+        ContactBuffer contacts;
+
+        PhysicsTimings timings;
+        PhaseClock clock;
 
     };
 }
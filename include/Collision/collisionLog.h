@@ -0,0 +1,83 @@
+#ifndef COLLISIONLOG_H
+#define COLLISIONLOG_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+#include <Object/id.h>
+
+namespace Hop::System::Physics
+{
+
+    using Hop::Object::Id;
+
+    struct CollisionType 
+    { 
+        CollisionType(Id i, bool w)
+        : with(i), world(w)
+        {}
+        Id with;
+        bool world;
+    };
+
+    /*
+        Which objects collided in a step, once per object pair 
+        (recorded both ways round) and once per object with the 
+        world. Repeats, from several primitives in contact, are 
+        dropped as they are inserted by an open addressing index 
+        of the entries. Lookups order the entries by object first
+        (as sort() does). The storage is reused step to step.
+    */
+    class CollisionLog
+    {
+
+    public:
+
+        using Entry = std::pair<Id, CollisionType>;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        void clear();
+
+        // record e, unless it already is
+        void insert(const Entry & e);
+
+        void append(const CollisionLog & other)
+        {
+            for (const Entry & e : other.entries)
+            {
+                insert(e);
+            }
+        }
+
+        // order by object, then with whom
+        void sort() { order(); }
+
+        // the collisions of id
+        std::pair<const_iterator, const_iterator> equal_range(const Id & id) const;
+        bool contains(const Id & id) const;
+
+        const_iterator begin() const { return entries.cbegin(); }
+        const_iterator end() const { return entries.cend(); }
+
+        size_t size() const { return entries.size(); }
+
+    private:
+
+        // ordered on demand, so lookups may sort a const log
+        mutable std::vector<Entry> entries;
+        mutable bool sorted = true;
+
+        // entry index + 1 per slot, 0 when empty, at most half full
+        mutable std::vector<uint32_t> slots;
+
+        void order() const;
+        void index() const;
+        bool place(uint32_t k) const;
+
+    };
+
+}
+
+#endif /* COLLISIONLOG_H */
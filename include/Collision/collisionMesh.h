@@ -20,44 +20,36 @@ namespace Hop::System::Physics
     using Hop::Object::Component::cTransform;
     using Hop::Object::Component::cPhysics;
 
+    /*
+        Model space circle or rectangle a CollisionPrimitive is
+        placed from, tagged by type as CollisionPrimitive is.
+    */
     struct MeshPoint
     {
-        MeshPoint(double x, double y, double r)
-        : x(x), y(y), r(r)
+        MeshPoint(Real x, Real y, Real r)
+        : x(x), y(y), r(r),
+          type(PrimitiveType::CIRCLE),
+          llx(0.0), lly(0.0),
+          ulx(0.0), uly(0.0),
+          urx(0.0), ury(0.0),
+          lrx(0.0), lry(0.0),
+          axis1x(0.0), axis1y(0.0),
+          axis2x(0.0), axis2y(0.0)
         {}
 
         MeshPoint()
-        : x(0.0), y(0.0), r(0.0)
+        : MeshPoint(0.0, 0.0, 0.0)
         {}
 
-        virtual ~MeshPoint() = default;
-
-        double x; double y; double r;
-
-        bool operator==(const MeshPoint & rhs)
-        {
-            return x == rhs.x && y == rhs.y && r == rhs.r;
-        }
-    };
-
-    struct MeshRectangle : public MeshPoint
-    {
-
-        MeshRectangle()
-        : MeshRectangle(0.0, 0.0,
-                    0.0, 0.0,
-                    0.0, 0.0,
-                    0.0, 0.0)
-        {}
-
-        MeshRectangle
+        MeshPoint
         (        
-            double llx, double lly,
-            double ulx, double uly,
-            double urx, double ury,
-            double lrx, double lry
+            Real llx, Real lly,
+            Real ulx, Real uly,
+            Real urx, Real ury,
+            Real lrx, Real lry
         )
-        : llx(llx), lly(lly),
+        : type(PrimitiveType::RECTANGLE),
+          llx(llx), lly(lly),
           ulx(ulx), uly(uly),
           urx(urx), ury(ury),
           lrx(lrx), lry(lry)
@@ -65,27 +57,52 @@ namespace Hop::System::Physics
             x = (llx+ulx+urx+lrx)/4.0;
             y = (lly+uly+ury+lry)/4.0;
 
-            double dx = llx-x;
-            double dy = lly-y;
+            Real dx = llx-x;
+            Real dy = lly-y;
 
             r = std::sqrt(dx*dx+dy*dy);
+
+            // unit axes as RectanglePrimitive::resetAxes, rotation
+            //  keeps them unit so world axes need no normalising
+            axis1x = llx-lrx;
+            axis1y = lly-lry;
+
+            Real d = std::sqrt(axis1x*axis1x+axis1y*axis1y);
+
+            axis1x /= d;
+            axis1y /= d;
+
+            axis2x = ulx-llx;
+            axis2y = uly-lly;
+
+            d = std::sqrt(axis2x*axis2x+axis2y*axis2y);
+
+            axis2x /= d;
+            axis2y /= d;
         }
 
-        bool operator==(const MeshRectangle & rhs)
+        Real x; Real y; Real r;
+
+        PrimitiveType type;
+
+        bool isRectangle() const { return type == PrimitiveType::RECTANGLE; }
+
+        bool operator==(const MeshPoint & rhs)
         {
-            return llx == rhs.llx && 
-                   lly == rhs.lly &&
-                   ulx == rhs.ulx &&
-                   uly == rhs.uly &&
-                   urx == rhs.urx &&
-                   ury == rhs.ury &&
-                   lrx == rhs.lrx &&
-                   lry == rhs.lry;
+            return x == rhs.x && y == rhs.y && r == rhs.r;
         }
 
-        double llx, lly, ulx, uly, urx, ury, lrx, lry;
+        Real llx, lly, ulx, uly, urx, ury, lrx, lry;
+        Real axis1x, axis1y, axis2x, axis2y;
     };
 
+    typedef MeshPoint MeshRectangle;
+
+    /*
+        Model and world space primitives, stored by value and
+        contiguously. Primitives are addressed by index, which is
+        stable until the mesh is edited (add/remove).
+    */
     struct CollisionMesh 
     {
         CollisionMesh()
@@ -93,16 +110,16 @@ namespace Hop::System::Physics
         // construct a mesh around a model space polygon 
         //   with vertices v with each mesh vertex having 
         //   radius r in model space
-        //CollisionMesh(std::vector<Vertex> v, double r = 0.01);
+        //CollisionMesh(std::vector<Vertex> v, Real r = 0.01);
 
         // construct a mesh from given points
         CollisionMesh
         (
-            std::vector<std::shared_ptr<CollisionPrimitive>> v,
-            double x,
-            double y, 
-            double theta, 
-            double scale
+            std::vector<CollisionPrimitive> v,
+            Real x,
+            Real y, 
+            Real theta, 
+            Real scale
         )
         : CollisionMesh(std::move(v))
         {
@@ -113,7 +130,7 @@ namespace Hop::System::Physics
 
         CollisionMesh
         (
-            std::vector<std::shared_ptr<CollisionPrimitive>> v
+            std::vector<CollisionPrimitive> v
         )
         : totalEffectiveMass(1.0), gx(0.0), gy(0.0)
         {
@@ -127,28 +144,8 @@ namespace Hop::System::Physics
 
         CollisionMesh
         (
-            CollisionMesh & m
-        )
-        {
-            vertices = m.vertices;
-            worldVertices = m.worldVertices;
-            tags = m.tags;
-
-            totalEffectiveMass = m.totalEffectiveMass;
-
-            radius = m.radius;
-            gx = m.gx;
-            gy = m.gy;
-            kineticEnergy = m.kineticEnergy;
-            isRigid = m.isRigid;
-            needsInit = m.needsInit;
-            someRectangles = m.someRectangles;
-        }
-
-        CollisionMesh
-        (
-            std::vector<std::shared_ptr<MeshPoint>> model,
-            std::vector<std::shared_ptr<CollisionPrimitive>> world,
+            std::vector<MeshPoint> model,
+            std::vector<CollisionPrimitive> world,
             std::set<uint64_t> tags
         )
         : vertices(model), worldVertices(world), tags(tags),
@@ -163,8 +160,15 @@ namespace Hop::System::Physics
 
         CollisionMesh getSubMesh(uint64_t t)
         {
-            auto model = getModelByTag(t);
-            auto world = getByTag(t);
+            std::vector<MeshPoint> model;
+            std::vector<CollisionPrimitive> world;
+
+            for (size_t i : getByTag(t))
+            {
+                model.push_back(vertices[i]);
+                world.push_back(worldVertices[i]);
+            }
+
             std::set<uint64_t> tags = {t};
             return CollisionMesh(model, world, tags);
         }
@@ -178,52 +182,42 @@ namespace Hop::System::Physics
             updateWorldMesh(t, phys, 0.0);
         }
         
-        void add(std::shared_ptr<CollisionPrimitive> c)
+        void add(const CollisionPrimitive & c)
         {
 
-            auto circ = std::make_shared<MeshPoint>
-            (
-                c->x, c->y, c->r
-            );
+            MeshPoint circ(c.x, c.y, c.r);
 
-            for (auto c : vertices)
+            for (MeshPoint & v : vertices)
             {
-                if (*c.get() == *circ.get())
+                if (v == circ)
                 {
                     return;
                 }
             }
 
-            RectanglePrimitive * l = dynamic_cast<RectanglePrimitive*>(c.get());
-
-            std::shared_ptr<CollisionPrimitive> p;
-
-            if (l != nullptr)
+            if (c.isRectangle())
             {
                 vertices.push_back
                 (
-                    std::move
+                    MeshRectangle
                     (
-                        std::make_shared<MeshRectangle>
-                        (
-                            l->llx, l->lly,
-                            l->ulx, l->uly,
-                            l->urx, l->ury,
-                            l->lrx, l->lry
-                        )
+                        c.llx, c.lly,
+                        c.ulx, c.uly,
+                        c.urx, c.ury,
+                        c.lrx, c.lry
                     )
                 );
 
-                p = std::make_shared<RectanglePrimitive>
+                worldVertices.push_back
                 (
                     RectanglePrimitive
                     (
-                        l->llx, l->lly,
-                        l->ulx, l->uly,
-                        l->urx, l->ury,
-                        l->lrx, l->lry,
-                        l->tag,
-                        l->stiffness
+                        c.llx, c.lly,
+                        c.ulx, c.uly,
+                        c.urx, c.ury,
+                        c.lrx, c.lry,
+                        c.tag,
+                        c.stiffness
                     )
                 );
 
@@ -232,30 +226,23 @@ namespace Hop::System::Physics
             }
             else
             {
-                vertices.push_back
-                (
-                    std::move
-                    (
-                        circ
-                    )
-                );
-                p = std::make_shared<CollisionPrimitive>
+                vertices.push_back(circ);
+
+                worldVertices.push_back
                 (
                     CollisionPrimitive
                     (
-                        c->x,
-                        c->y,
-                        c->r, 
-                        c->tag,
-                        c->stiffness, 
-                        c->damping, 
-                        c->effectiveMass
+                        c.x,
+                        c.y,
+                        c.r, 
+                        c.tag,
+                        c.stiffness, 
+                        c.damping, 
+                        c.effectiveMass
                     )
                 );
             }
 
-            worldVertices.push_back(std::move(p));
-
             calculateIsRigid();
             calculateTotalEffectiveMass();
             updateTags();
@@ -279,11 +266,11 @@ namespace Hop::System::Physics
 
             for (int j = 0; j < int(worldVertices.size()); j++)
             {
-                double rx = worldVertices[j]->x - x;
-                double ry = worldVertices[j]->y - y;
-                double d2 = rx*rx+ry*ry;
+                Real rx = worldVertices[j].x - x;
+                Real ry = worldVertices[j].y - y;
+                Real d2 = rx*rx+ry*ry;
 
-                if (d2 < worldVertices[j]->r*worldVertices[j]->r)
+                if (d2 < worldVertices[j].r*worldVertices[j].r)
                 {
                     return j;
                 }
@@ -292,27 +279,38 @@ namespace Hop::System::Physics
             return -1;
         }
 
-        size_t size(){return vertices.size();}
+        size_t size() const {return vertices.size();}
 
-        std::shared_ptr<MeshPoint> getModelVertex(size_t i)
+        MeshPoint & getModelVertex(size_t i)
         {
             return vertices[i];
         }
 
-        std::shared_ptr<CollisionPrimitive> getMeshVertex(size_t i)
+        CollisionPrimitive & getMeshVertex(size_t i)
         {
             return worldVertices[i];
         }
 
-        std::shared_ptr<CollisionPrimitive> operator[](size_t i) 
+        CollisionPrimitive & operator[](size_t i) 
         {
             return worldVertices[i];
         }
 
+        const CollisionPrimitive & operator[](size_t i) const
+        {
+            return worldVertices[i];
+        }
+
+        /*
+            subCycles is the number of steps of size dt/subCycles the
+            soft mesh's internal springs take per call, see
+            updateWorldMeshSoft. Rigid meshes ignore it.
+        */
         void updateWorldMesh(
             cTransform & transform,
             cPhysics & physics,
-            double dt
+            Real dt,
+            unsigned subCycles = 1
         )
         {
             kineticEnergy = 0.0;
@@ -322,36 +320,41 @@ namespace Hop::System::Physics
             }
             else 
             {
-                return updateWorldMeshSoft(transform, physics, dt);
+                return updateWorldMeshSoft(transform, physics, dt, subCycles);
             }
         }
 
         void updateWorldMeshRigid(
             const cTransform & transform,
-            double dt
+            Real dt
         );
 
         void updateWorldMeshSoft(
             cTransform & transform,
             cPhysics & physics,
-            double dt
+            Real dt,
+            unsigned subCycles = 1
         );
 
-        double bestAngle(double x, double y, double scale);
-        void centerOfMassWorld(double & cx, double & cy);
+        Real bestAngle(Real x, Real y, Real scale);
+        void centerOfMassWorld(Real & cx, Real & cy);
         void modelToCenterOfMassFrame();
 
-        double momentOfInertia(double x, double y, double mass);
+        Real momentOfInertia(Real x, Real y, Real mass);
         void computeRadius();
-        double getRadius(){return radius;}
+        Real getRadius(){return radius;}
+
+        // centre of the circle of radius getRadius bounding the mesh
+        Real getBoundsX() const { return boundsX; }
+        Real getBoundsY() const { return boundsY; }
 
         bool getIsRigid(){ return isRigid; }
 
         void calculateIsRigid() 
         {
-            for (auto v : worldVertices)
+            for (const CollisionPrimitive & v : worldVertices)
             {
-                if (v->stiffness < CollisionPrimitive::RIGID)
+                if (v.stiffness < CollisionPrimitive::RIGID)
                 {
                     isRigid = false;
                     return;
@@ -360,7 +363,7 @@ namespace Hop::System::Physics
             isRigid = true;
         }
 
-        void applyForce(double fx, double fy, bool global = false)
+        void applyForce(Real fx, Real fy, bool global = false)
         {
             if (global)
             {
@@ -369,22 +372,36 @@ namespace Hop::System::Physics
             }
             else 
             {
-                for (auto w : worldVertices)
+                for (CollisionPrimitive & w : worldVertices)
                 {
-                    w->applyForce(fx, fy);
+                    w.applyForce(fx, fy);
                 }
             }
 
         }
 
-        double getEffectiveMass() const { return totalEffectiveMass; }
+        /*
+            The Verlet history (xp, yp) is one time step's displacement,
+            so when the time step changes by ratio it is rescaled to
+            keep primitives' velocities.
+        */
+        void rescaleTimeStep(Real ratio)
+        {
+            for (CollisionPrimitive & w : worldVertices)
+            {
+                w.xp = w.x - (w.x-w.xp)*ratio;
+                w.yp = w.y - (w.y-w.yp)*ratio;
+            }
+        }
+
+        Real getEffectiveMass() const { return totalEffectiveMass; }
 
         void calculateTotalEffectiveMass() 
         {
             totalEffectiveMass = 0.0;
-            for (auto v : worldVertices)
+            for (const CollisionPrimitive & v : worldVertices)
             {
-                totalEffectiveMass += v->effectiveMass;
+                totalEffectiveMass += v.effectiveMass;
             }
 
             if (totalEffectiveMass <= 0.0)
@@ -393,7 +410,7 @@ namespace Hop::System::Physics
             }
         }
 
-        double energy()
+        Real energy()
         {
             return kineticEnergy;
         }
@@ -403,44 +420,26 @@ namespace Hop::System::Physics
         void updateTags()
         {
             tags.clear();
-            for (const std::shared_ptr<CollisionPrimitive> & c : worldVertices)
+            for (const CollisionPrimitive & c : worldVertices)
             {
-                tags.insert(c->tag);
+                tags.insert(c.tag);
             }
         }
 
-        std::vector<std::shared_ptr<CollisionPrimitive>> getByTag(uint64_t t)
+        // indices of primitives with tag t
+        std::vector<size_t> getByTag(uint64_t t) const
         {
-            std::vector<std::shared_ptr<CollisionPrimitive>> v;
+            std::vector<size_t> v;
             if (tags.find(t) == tags.cend())
             {
                 return v;
             }
 
-            for (std::shared_ptr<CollisionPrimitive> & c : worldVertices)
+            for (size_t i = 0; i < worldVertices.size(); i++)
             {
-                if (c->tag == t)
+                if (worldVertices[i].tag == t)
                 {
-                    v.push_back(c);
-                }
-            }
-
-            return v;
-        }
-
-        std::vector<std::shared_ptr<MeshPoint>> getModelByTag(uint64_t t)
-        {
-            std::vector<std::shared_ptr<MeshPoint>> v;
-            if (tags.find(t) == tags.cend())
-            {
-                return v;
-            }
-
-            for (unsigned i = 0; i < size(); i++)
-            {
-                if (worldVertices[i]->tag == t)
-                {
-                    v.push_back(vertices[i]);
+                    v.push_back(i);
                 }
             }
 
@@ -449,8 +448,6 @@ namespace Hop::System::Physics
 
         void removeByTag(uint64_t t)
         {
-            std::vector<std::shared_ptr<CollisionPrimitive>> v;
-
             if (tags.find(t) == tags.cend())
             {
                 return;
@@ -459,7 +456,7 @@ namespace Hop::System::Physics
             unsigned i = 0;
             while (i < worldVertices.size())
             {
-                if (worldVertices[i]->tag == t)
+                if (worldVertices[i].tag == t)
                 {
                     remove(i);
                 }
@@ -472,31 +469,36 @@ namespace Hop::System::Physics
 
         Hop::Maths::BoundingBox getBoundingBox() const
         {
-            return getBoundingBox(worldVertices);
+            std::vector<size_t> all(worldVertices.size());
+            for (size_t i = 0; i < all.size(); i++)
+            {
+                all[i] = i;
+            }
+            return getBoundingBox(all);
         }
 
         Hop::Maths::BoundingBox getBoundingBox
         (
-            const std::vector<std::shared_ptr<CollisionPrimitive>> & c
+            const std::vector<size_t> & indices
         ) const
         {
-            std::vector<Vertex> v(c.size());
+            std::vector<Vertex> v(indices.size());
             std::transform
             (
-                c.begin(), 
-                c.end(), 
+                indices.begin(), 
+                indices.end(), 
                 v.begin(),
-                [](std::shared_ptr<CollisionPrimitive> c)
+                [this](size_t i)
                 {
-                    return Vertex(c->x, c->y);
+                    return Vertex(worldVertices[i].x, worldVertices[i].y);
                 }
             );
 
-            double r = 0.0;
+            Real r = 0.0;
 
-            for (const std::shared_ptr<CollisionPrimitive> & c : worldVertices)
+            for (const CollisionPrimitive & c : worldVertices)
             {
-                r = std::max(r, c->r);
+                r = std::max(r, c.r);
             }
             
             return Hop::Maths::boundingBox(v, r);
@@ -504,27 +506,46 @@ namespace Hop::System::Physics
 
         Hop::Maths::BoundingBox getBoundingBox(uint64_t tag)
         {
-            std::vector<std::shared_ptr<CollisionPrimitive>> c = getByTag(tag);
-            return getBoundingBox(c);
+            return getBoundingBox(getByTag(tag));
         }
 
         std::set<uint64_t> getTags() const { return tags; }
         
     private:
 
-        std::vector<std::shared_ptr<MeshPoint>> vertices;
-        std::vector<std::shared_ptr<CollisionPrimitive>> worldVertices;
+        std::vector<MeshPoint> vertices;
+        std::vector<CollisionPrimitive> worldVertices;
         std::set<uint64_t> tags;
 
-        double totalEffectiveMass;
+        Real totalEffectiveMass;
 
-        double radius;
+        Real radius;
+        Real boundsX = 0.0, boundsY = 0.0;
 
-        double gx, gy, kineticEnergy;
+        Real gx, gy, kineticEnergy;
 
         bool isRigid = true;
         bool needsInit = false;
         bool someRectangles = false;
+
+        void placeRectangles
+        (
+            Real cosine,
+            Real sine,
+            Real scale,
+            Real x,
+            Real y
+        );
+
+        // updateWorldMeshSoft's spring step as subCycles shorter steps
+        void subCycleSoft
+        (
+            const cTransform & transform,
+            const cPhysics & physics,
+            Real dt,
+            Real phi,
+            unsigned subCycles
+        );
     };
 
 }
@@ -9,6 +9,7 @@
 #include <Maths/rectangle.h>
 #include <Maths/transform.h>
 #include <Component/cPhysics.h>
+#include <Util/real.h>
 
 namespace Hop::System::Physics
 {
@@ -18,66 +19,115 @@ namespace Hop::System::Physics
 
     const uint64_t LAST_INSIDE_COUNTER_MAX = 60;
 
+    enum class PrimitiveType : uint8_t {CIRCLE, RECTANGLE};
+
+    /*
+        A circle or rectangle collision primitive, tagged by type.
+
+        Rectangle data is held inline (unused by circles) so meshes
+        can store primitives by value, contiguously, and dispatch
+        on type without RTTI.
+    */
     struct CollisionPrimitive 
     {
 
-        static constexpr double RIGID = 1e6;
+        static constexpr Real RIGID = 1e6;
 
-        CollisionPrimitive() = default;
+        CollisionPrimitive()
+        : CollisionPrimitive(0.0,0.0,0.0,0,CollisionPrimitive::RIGID,0.0,0.0)
+        {}
 
         CollisionPrimitive
         (
-            double x, 
-            double y, 
-            double r, 
+            Real x, 
+            Real y, 
+            Real r, 
             uint64_t t = 0,
-            double k = CollisionPrimitive::RIGID,
-            double d = 1.0,
-            double m = 1.0
+            Real k = CollisionPrimitive::RIGID,
+            Real d = 1.0,
+            Real m = 1.0
         )
         : x(x),y(y),r(r),lastInside(0),
           ox(x),oy(y),fx(0),fy(0),
           xp(x),yp(y),
           vx(0),vy(0),
           roxp(0.0), royp(0.0),
-          stiffness(k), effectiveMass(m), damping(d), tag(t)
+          stiffness(k), effectiveMass(m), damping(d), tag(t),
+          type(PrimitiveType::CIRCLE),
+          llx(0.0), lly(0.0),
+          ulx(0.0), uly(0.0),
+          urx(0.0), ury(0.0),
+          lrx(0.0), lry(0.0),
+          axis1x(0.0), axis1y(0.0),
+          axis2x(0.0), axis2y(0.0)
         {}
 
-        virtual ~CollisionPrimitive() = default;
+        CollisionPrimitive
+        (        
+            Real llx, Real lly,
+            Real ulx, Real uly,
+            Real urx, Real ury,
+            Real lrx, Real lry,
+            uint64_t t = 0,
+            Real k = CollisionPrimitive::RIGID
+        )
+        : lastInside(0),
+          fx(0.0), fy(0.0),
+          vx(0.0), vy(0.0),
+          roxp(0.0), royp(0.0),
+          stiffness(k), effectiveMass(1.0), damping(0.0), tag(t),
+          type(PrimitiveType::RECTANGLE),
+          llx(llx), lly(lly),
+          ulx(ulx), uly(uly),
+          urx(urx), ury(ury),
+          lrx(lrx), lry(lry)
+        {
+            resetAxes();
+
+            xp = x;
+            yp = y;
+            ox = x;
+            oy = y;
+        }
+
         // x position, y position, radius (model space)
         //  of a collision point
-        double x, y, r;
+        Real x, y, r;
         uint64_t lastInside;
 
-        double ox, oy;
+        Real ox, oy;
 
-        double fx, fy, xp, yp, vx, vy, roxp, royp;
+        Real fx, fy, xp, yp, vx, vy, roxp, royp;
 
-        double stiffness = CollisionPrimitive::RIGID;
-        double effectiveMass, damping;
+        Real stiffness = CollisionPrimitive::RIGID;
+        Real effectiveMass, damping;
 
         uint64_t tag;
 
+        PrimitiveType type;
+
+        bool isRectangle() const { return type == PrimitiveType::RECTANGLE; }
+
         void setRecentlyInside(int i){ lastInside =  i; }
         bool recentlyInside() const { return lastInside > 0; }
 
         bool isRigid() { return stiffness >= RIGID; }
 
-        void applyForce(double x, double y)
+        void applyForce(Real x, Real y)
         {
             fx+=x;
             fy+=y;
         }
 
-        double energy()
+        Real energy()
         {
             return effectiveMass*(vx*vx+vy*vy);
         }
 
         void setOrigin
         (
-            double nox, 
-            double noy
+            Real nox, 
+            Real noy
         )
         {
             ox = nox;
@@ -90,9 +140,9 @@ namespace Hop::System::Physics
 
         void applyTorque
         (
-            double omega,
-            double cx,
-            double cy
+            Real omega,
+            Real cx,
+            Real cy
         )
         {
             /*
@@ -115,10 +165,10 @@ namespace Hop::System::Physics
 
             */
 
-            double rcx = x-cx;
-            double rcy = y-cy;
-            double rc2 = rcx*rcx + rcy*rcy;
-            double tau = omega * effectiveMass * (0.5*r*r + rc2);
+            Real rcx = x-cx;
+            Real rcy = y-cy;
+            Real rc2 = rcx*rcx + rcy*rcy;
+            Real tau = omega * effectiveMass * (0.5*r*r + rc2);
             
             applyForce
             (
@@ -129,33 +179,38 @@ namespace Hop::System::Physics
 
         void step
         (
-            double dt,
-            double dtdt,
-            double translationalDrag,
-            double nox,
-            double noy
+            Real dt,
+            Real dtdt,
+            Real translationalDrag,
+            Real nox,
+            Real noy,
+            bool clearForce = true
         )
         {
 
-            double ct = translationalDrag*dt / (2.0*effectiveMass);
-            double bt = 1.0/(1.0+ct);
-            double at = (1.0-ct)*bt;
+            Real ct = translationalDrag*dt / (2.0*effectiveMass);
+            Real bt = 1.0/(1.0+ct);
+            Real at = (1.0-ct)*bt;
 
             ox = nox;
             oy = noy;
 
-            double rox = x-ox;
-            double roy = y-oy;
+            Real rox = x-ox;
+            Real roy = y-oy;
 
             // spring with relaxed state at ox, oy;
-            double ax = (fx-stiffness*rox-damping*vx)/effectiveMass;
-            double ay = (fy-stiffness*roy-damping*vy)/effectiveMass;
+            Real ax = (fx-stiffness*rox-damping*vx)/effectiveMass;
+            Real ay = (fy-stiffness*roy-damping*vy)/effectiveMass;
 
-            fx = 0.0;
-            fy = 0.0;
+            // kept when sub cycling, so the force is held over the sub steps
+            if (clearForce)
+            {
+                fx = 0.0;
+                fy = 0.0;
+            }
 
-            double xtp = x;
-            double ytp = y;
+            Real xtp = x;
+            Real ytp = y;
 
             x = 2.0*bt*x - at*xp + bt*ax*dtdt;
             y = 2.0*bt*y - at*yp + bt*ay*dtdt;
@@ -173,26 +228,26 @@ namespace Hop::System::Physics
 
         void stepGlobal
         (
-            double dt,
-            double dtdt,
+            Real dt,
+            Real dtdt,
             const cPhysics & physics,
-            double gx,
-            double gy,
-            double & dx,
-            double & dy
+            Real gx,
+            Real gy,
+            Real & dx,
+            Real & dy
         )
         {
 
-            double ct = physics.translationalDrag*dt / (2.0*physics.mass);
-            double bt = 1.0/(1.0+ct);
-            double at = (1.0-ct)*bt;
+            Real ct = physics.translationalDrag*dt / (2.0*physics.mass);
+            Real bt = 1.0/(1.0+ct);
+            Real at = (1.0-ct)*bt;
             // not impacted by damping forces on mesh
 
-            double xtp = x;
-            double ytp = y;
+            Real xtp = x;
+            Real ytp = y;
 
-            double ax = gx/physics.mass;
-            double ay = gy/physics.mass;
+            Real ax = gx/physics.mass;
+            Real ay = gy/physics.mass;
 
             x = 2.0*bt*x - at*xp + bt*ax*dtdt;
             y = 2.0*bt*y - at*yp + bt*ay*dtdt;
@@ -202,59 +257,7 @@ namespace Hop::System::Physics
             yp = ytp;
         }
 
-    };
-
-    struct RectanglePrimitive : public CollisionPrimitive 
-    {
-        RectanglePrimitive()
-        : CollisionPrimitive(0.0,0.0,0.0,0,CollisionPrimitive::RIGID,0.0,0.0)
-        {}
-
-        RectanglePrimitive
-        (        
-            double llx, double lly,
-            double ulx, double uly,
-            double urx, double ury,
-            double lrx, double lry,
-            uint64_t t = 0,
-            double k = CollisionPrimitive::RIGID
-        )
-        :
-          llx(llx), lly(lly),
-          ulx(ulx), uly(uly),
-          urx(urx), ury(ury),
-          lrx(lrx), lry(lry)
-        {
-            tag = t;
-
-            x = (llx+ulx+urx+lrx)/4.0;
-            y = (lly+uly+ury+lry)/4.0;
-
-            stiffness = k;
-
-            double dx = llx-x;
-            double dy = lly-y;
-
-            r = std::sqrt(dx*dx+dy*dy);
-
-            lastInside = 0;
-
-            resetAxes();
-
-            damping = 0.0;
-            stiffness = k;
-            effectiveMass = 1.0;
-            xp = x;
-            yp = y;
-            ox = x;
-            oy = y;
-            vx = 0.0;
-            vy = 0.0;
-            fx = 0.0;
-            fy = 0.0;
-            roxp=0.0;
-            royp=0.0;
-        }
+        // rectangle data and operations
 
         Hop::Maths::Rectangle getRect()
         {
@@ -277,12 +280,12 @@ namespace Hop::System::Physics
             x = (llx+ulx+urx+lrx)/4.0;
             y = (lly+uly+ury+lry)/4.0;
 
-            double dx = llx-x;
-            double dy = lly-y;
+            Real dx = llx-x;
+            Real dy = lly-y;
 
             r = std::sqrt(dx*dx+dy*dy);
 
-            double d = std::sqrt(axis1x*axis1x+axis1y*axis1y);
+            Real d = std::sqrt(axis1x*axis1x+axis1y*axis1y);
 
             axis1x /= d;
             axis1y /= d;
@@ -296,39 +299,39 @@ namespace Hop::System::Physics
             axis2y /= d;
         }
         
-        double height()
+        Real height()
         {
 
-            double u = llx-lrx;
-            double v = lly-lry;
+            Real u = llx-lrx;
+            Real v = lly-lry;
 
             return std::sqrt(u*u+v*v);
 
         }
 
-        double width()
+        Real width()
         {
 
-            double u = ulx-llx;
-            double v = uly-lly;
+            Real u = ulx-llx;
+            Real v = uly-lly;
 
             return std::sqrt(u*u+v*v);
 
         }
 
-        void rotateClockWise(double cosine, double sine)
+        void rotateClockWise(Real cosine, Real sine)
         {
-            Hop::Maths::rotateClockWise<double>(llx, lly, cosine, sine);
-            Hop::Maths::rotateClockWise<double>(ulx, uly, cosine, sine);
-            Hop::Maths::rotateClockWise<double>(urx, ury, cosine, sine);
-            Hop::Maths::rotateClockWise<double>(lrx, lry, cosine, sine);
+            Hop::Maths::rotateClockWise<Real>(llx, lly, cosine, sine);
+            Hop::Maths::rotateClockWise<Real>(ulx, uly, cosine, sine);
+            Hop::Maths::rotateClockWise<Real>(urx, ury, cosine, sine);
+            Hop::Maths::rotateClockWise<Real>(lrx, lry, cosine, sine);
 
-            Hop::Maths::rotateClockWise<double>(x,y,cosine,sine);
+            Hop::Maths::rotateClockWise<Real>(x,y,cosine,sine);
 
             resetAxes();
         }
 
-        void scale(double s)
+        void scale(Real s)
         {
             llx *= s;
             lly *= s;
@@ -348,32 +351,38 @@ namespace Hop::System::Physics
             r *= s;
         }
 
-        void translate(double x, double y)
+        void translate(Real dx, Real dy)
         {
-            llx += x;
-            lly += y;
+            llx += dx;
+            lly += dy;
 
-            ulx += x;
-            uly += y;
+            ulx += dx;
+            uly += dy;
 
-            urx += x;
-            ury += y;
+            urx += dx;
+            ury += dy;
 
-            lrx += x;
-            lry += y;
+            lrx += dx;
+            lry += dy;
 
-            x += x;
-            y += y;
+            x += dx;
+            y += dy;
         }
 
-        double llx, lly;
-        double ulx, uly;
-        double urx, ury;
-        double lrx, lry;
-        double axis1x, axis1y;
-        double axis2x, axis2y;
+        Real llx, lly;
+        Real ulx, uly;
+        Real urx, ury;
+        Real lrx, lry;
+        Real axis1x, axis1y;
+        Real axis2x, axis2y;
     };
 
+    /*
+        Rectangles share CollisionPrimitive's storage, constructed
+        from their corners and tagged PrimitiveType::RECTANGLE.
+    */
+    typedef CollisionPrimitive RectanglePrimitive;
+
     std::ostream & operator<<(std::ostream & o, RectanglePrimitive const & r);
 
 }
@@ -2,6 +2,7 @@
 #define COLLISIONRESOLVER_H
 
 #include <string>
+#include <limits>
 #include <Object/id.h>
 
 #include <jThread/jThread.h>
@@ -12,6 +13,8 @@
 #include <Component/cPhysics.h>
 #include <Component/cCollideable.h>
 
+#include <Collision/contactBuffer.h>
+
 namespace Hop::World 
 {
     class AbstractWorld;
@@ -44,40 +47,45 @@ namespace Hop::System::Physics
             cPhysics & pI, cPhysics & pJ
         ) = 0;
 
-        virtual bool handleObjectWorldCollision
-        (
-            Id id,
-            cCollideable & dataC,
-            cPhysics & dataP,
-            AbstractWorld * world
-        ) = 0;
-
-        virtual void collisionForce
+        /*
+            Narrow phase only, append the contacts of primitive
+            particleI of objectI with particleJ of objectJ, whose
+            forces evaluateContacts leaves for contacts.apply.
+            Returns whether the pair collided.
+        */
+        virtual bool findContacts
         (
+            Id & objectI, uint64_t particleI,
+            Id & objectJ, uint64_t particleJ,
+            cCollideable & cI, cCollideable & cJ,
             cPhysics & pI, cPhysics & pJ,
-            RectanglePrimitive * li,
-            RectanglePrimitive * lj,
-            bool wall
+            ContactBuffer & contacts
         ) = 0;
 
-        virtual void collisionForce
+        // fill the force columns of contacts [begin, end)
+        virtual void evaluateContacts
         (
-            cPhysics & pI, cPhysics & pJ,
-            CollisionPrimitive * c,
-            RectanglePrimitive * l,
-            double rx, double ry, double rc, double dd
+            ContactBuffer & contacts,
+            size_t begin,
+            size_t end
         ) = 0;
 
-        virtual void collisionForce
+        // called once per step before the object world collisions
+        virtual void prepareWorld(AbstractWorld * world) {}
+
+        virtual bool handleObjectWorldCollision
         (
-            cPhysics & pI, cPhysics & pJ,
-            CollisionPrimitive * c,
-            CollisionPrimitive * l,
-            double rx, double ry, double rc, double dd
+            Id id,
+            cCollideable & dataC,
+            cPhysics & dataP,
+            AbstractWorld * world
         ) = 0;
 
-        virtual void setCoefRestitution(double cor) = 0;
-        virtual void setSurfaceFriction(double f) = 0;
+        virtual void setCoefRestitution(Real cor) = 0;
+        virtual void setSurfaceFriction(Real f) = 0;
+
+        // duration of a contact, which time steps must resolve
+        virtual Real getCollisionTime() const { return std::numeric_limits<Real>::infinity(); }
 
     };
 
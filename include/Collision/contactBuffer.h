@@ -0,0 +1,138 @@
+#ifndef CONTACTBUFFER_H
+#define CONTACTBUFFER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <Object/id.h>
+#include <Util/real.h>
+#include <Component/cPhysics.h>
+#include <Collision/collisionPrimitive.h>
+
+namespace Hop::System::Physics
+{
+
+    using Hop::Object::Id;
+    using Hop::Object::Component::cPhysics;
+    using Hop::Real;
+
+    enum class ContactType : uint8_t {CIRCLE, RECTANGLE};
+
+    /*
+        A contact found by the narrow phase, directed from primitive
+        pi of object i onto primitive pj of object j. A pair of
+        primitives may give several, one for each direction or
+        corner in contact.
+    */
+    struct Contact
+    {
+        Id i, j;
+        uint64_t pi, pj;
+
+        ContactType type;
+
+        // unit normal from i towards j, and how far they overlap
+        Real nx, ny, overlap;
+
+        // where the force acts on i
+        Real px, py;
+
+        // velocity damped, of i relative to j (of i for rectangles)
+        Real vx, vy;
+
+        // force on i (j has the opposite), zero if separating
+        Real fx, fy;
+    };
+
+    /*
+        The contacts of a step as packed (structure of arrays)
+        columns. The narrow phase appends with add, a resolver
+        fills the force columns (see SpringDashpot::evaluateContacts),
+        and apply scatters them to the objects and primitives in
+        the order they were added.
+    */
+    class ContactBuffer
+    {
+
+    public:
+
+        ContactBuffer(){}
+
+        void clear();
+
+        size_t size() const { return i.size(); }
+
+        /*
+            Record a contact, a and b are i's and j's physics, soft
+            objects take forces on their primitives ca and cb.
+        */
+        void add
+        (
+            const Id & idi, uint64_t particleI,
+            const Id & idj, uint64_t particleJ,
+            cPhysics * a, cPhysics * b,
+            CollisionPrimitive * ca, CollisionPrimitive * cb,
+            bool softA, bool softB,
+            ContactType type,
+            Real normalX, Real normalY, Real depth,
+            Real distanceScale,
+            Real effectiveMass, Real friction,
+            Real velocityX, Real velocityY,
+            Real pointX, Real pointY,
+            Real leverAX, Real leverAY,
+            Real leverBX, Real leverBY,
+            bool applyToPrimitives = true
+        );
+
+        // move other's contacts onto the end of these
+        void append(ContactBuffer & other);
+
+        // add the evaluated forces and torques, in order
+        void apply();
+
+        // a read only copy of contact k
+        Contact operator[](size_t k) const;
+
+        /*
+            Kernel inputs, per contact.
+
+                scale     multiplies the spring and dashpot
+                tangent   1 for circles, -1 for rectangles, sign
+                          of the unflipped tangent (-ny, nx)
+                friction  coefficient on i's tangential force
+                lever     point of action less i's (a) and
+                          j's (b) centre
+        */
+        std::vector<Real> nx, ny, overlap, scale;
+        std::vector<Real> mass, friction, tangent;
+        std::vector<Real> vx, vy;
+        std::vector<Real> px, py;
+        std::vector<Real> leverAX, leverAY, leverBX, leverBY;
+
+        /*
+            Kernel outputs, per contact. Force fa on i, fb taken
+            from j, torques tauA taken from i and tauB added to j,
+            and fp the force on i's primitive (opposite on j's).
+            Inactive contacts only apply fp.
+        */
+        std::vector<Real> fax, fay, fbx, fby, tauA, tauB, fpx, fpy;
+        std::vector<uint8_t> active;
+
+    private:
+
+        std::vector<Id> i, j;
+        std::vector<uint64_t> pi, pj;
+        std::vector<ContactType> type;
+
+        std::vector<cPhysics*> a, b;
+        std::vector<CollisionPrimitive*> ca, cb;
+
+        // bit 0 soft i, bit 1 soft j, bit 2 apply fp
+        std::vector<uint8_t> flags;
+
+    };
+
+}
+
+#endif /* CONTACTBUFFER_H */
@@ -0,0 +1,93 @@
+#ifndef NEIGHBOURLIST_H
+#define NEIGHBOURLIST_H
+
+#include <Collision/cellList.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Hop::System::Physics
+{
+
+    /*
+        Verlet neighbour list broad phase. Candidate pairs within
+        contact distance plus a skin are built from a cell list,
+        then reused each step until some primitive has moved more
+        than half the skin (or objects, meshes or the grid change).
+
+        The grid's cells are widened by the skin so candidates are
+        still found in neighbouring cells.
+    */
+    class NeighbourList : public CellList
+    {
+    public:
+
+        NeighbourList(AbstractWorld * world, double skin);
+
+        NeighbourList(double skin, uint64_t n, tupled lx = tupled(0.0,1.0), tupled ly = tupled(0.0,1.0));
+
+        void centreOn(double x, double y);
+
+        double getSkin() const { return skin; }
+
+        // number of times the lists have been built
+        uint64_t getBuilds() const { return builds; }
+
+        // candidate pairs in the current lists
+        uint64_t pairs() const { return neighbours.size(); }
+
+    private:
+
+        double skin;
+        bool stale;
+        uint64_t builds;
+
+        // binned primitive k's candidates, neighbours[neighbourStart[k]] ...
+        std::vector<uint64_t> neighbourStart;
+        std::vector<uint64_t> neighbours;
+
+        /*
+            What the lists were built from. The arrays' versions
+            change when objects join, leave or are reordered. Every
+            primitive of each binned object o is tracked from
+            trackStart[o], with its position at the last build.
+        */
+        uint64_t builtVersionC, builtVersionP;
+        std::vector<uint64_t> trackStart;
+        std::vector<double> x0, y0;
+
+        bool needsBuild
+        (
+            ComponentArray<cCollideable> & dataC,
+            ComponentArray<cPhysics> & dataP,
+            CollideableView & objects
+        );
+
+        void build
+        (
+            ComponentArray<cCollideable> & dataC,
+            ComponentArray<cPhysics> & dataP,
+            CollideableView & objects
+        );
+
+        void cellNeighbours
+        (
+            uint64_t k,
+            uint64_t a,
+            uint64_t b,
+            ComponentArray<cCollideable> & dataC
+        );
+
+        void handleObjectObjectCollisions(
+            ComponentArray<cCollideable> & dataC,
+            ComponentArray<cPhysics> & dataP,
+            CollisionResolver * resolver,
+            CollideableView & objects,
+            ThreadPool * workers = nullptr
+        );
+
+    };
+
+}
+
+#endif /* NEIGHBOURLIST_H */
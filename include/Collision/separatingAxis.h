@@ -0,0 +1,29 @@
+#ifndef SEPARATINGAXIS_H
+#define SEPARATINGAXIS_H
+
+#include <Collision/collisionPrimitive.h>
+
+namespace Hop::System::Physics
+{
+
+    /*
+        Separating axis test of two rectangles over their four
+        cached world space axes, projecting all eight corners on
+        every axis at once (SIMD where available).
+
+        As Hop::Maths::rectangleRectangleCollided, true when every
+        axis overlaps, with nx, ny the axis of least overlap s (the
+        first on ties, in the order r1 axis1, axis2, r2 axis1, axis2).
+    */
+    bool rectanglesOverlap
+    (
+        const RectanglePrimitive & r1,
+        const RectanglePrimitive & r2,
+        Real & nx,
+        Real & ny,
+        Real & s
+    );
+
+}
+
+#endif /* SEPARATINGAXIS_H */
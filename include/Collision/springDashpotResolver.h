@@ -1,12 +1,13 @@
 #ifndef SPRINGDASHPOTRESOLVER_H
 #define SPRINGDASHPOTRESOLVER_H
 
-#include <set>
 #include <iterator>
 #include <cmath>
 
 #include <Collision/collisionResolver.h>
 #include <Collision/collisionMesh.h>
+#include <Collision/contactBuffer.h>
+#include <Collision/separatingAxis.h>
 #include <Component/cPhysics.h>
 
 #include <World/tileWorld.h>
@@ -25,19 +26,25 @@ namespace Hop::System::Physics
     using Hop::World::Tile;
     using Hop::World::TileBoundsData;
     using Hop::World::TileNeighbourData;
+    using Hop::World::TileSegment;
+    using Hop::World::TileSide;
 
     const double WALL_MASS_MULTIPLIER = 10.0;
     // will check collision with neigbhours tiles when
     // primitive is less than size*this away
     const double NEIGHBOUR_TILE_CHECK_ZONE_MULTIPLIER = 1.1;
 
-    class SpringDashpot : public CollisionResolver 
+    /*
+        Final, so calls between its force routines are direct and
+        may be inlined into the pair kernels below.
+    */
+    class SpringDashpot final : public CollisionResolver 
     {
     public:
         SpringDashpot(
-            double tc,
-            double cor,
-            double f
+            Real tc,
+            Real cor,
+            Real f
         )
         {
             updateParameters(tc,cor);
@@ -57,6 +64,29 @@ namespace Hop::System::Physics
             cPhysics & pI, cPhysics & pJ
         );
 
+        bool findContacts(
+            Id & objectI, uint64_t particleI,
+            Id & objectJ, uint64_t particleJ,
+            cCollideable & cI, cCollideable & cJ,
+            cPhysics & pI, cPhysics & pJ,
+            ContactBuffer & contacts
+        );
+
+        /*
+            Spring dashpot forces of contacts [begin, end), one
+            kernel over Lanes (Util/lanes.h), 4 (AVX) or 2 (SSE2)
+            per instruction, 8 and 4 with HOP_SINGLE_PRECISION,
+            with the tail a Lane at a time.
+        */
+        void evaluateContacts(
+            ContactBuffer & contacts,
+            size_t begin,
+            size_t end
+        );
+
+        // resolve the world and boundary types for the coming step
+        void prepareWorld(AbstractWorld * world);
+
         bool handleObjectWorldCollision(
             Id id,
             cCollideable & dataC,
@@ -64,66 +94,34 @@ namespace Hop::System::Physics
             AbstractWorld * world
         );
 
-        void handleObjectWorldCollisions(
-            ComponentArray<cCollideable> & dataC,
-            ComponentArray<cPhysics> & dataP,
-            std::set<Id>::iterator start,
-            std::set<Id>::iterator end,
-            AbstractWorld * world
-        );
-
-        void springDashpotForceCircles
-        (
-            cPhysics & pI, cPhysics & pJ,
-            double dd, double rx, double ry, double rc, double me,
-            double pxi, double pyi, double pxj, double pyj,
-            double & fx, double & fy
-        );
-
         void springDashpotWallForceCircle
         (
-            double nx,
-            double ny,
-            double d2,
-            double r,
-            double m,
-            double px, double py,
+            Real nx,
+            Real ny,
+            Real d2,
+            Real r,
+            Real m,
+            Real px, Real py,
             cPhysics & dataP,
-            double & fx, double & fy
+            Real & fx, Real & fy
         );
 
         void springDashpotForceRect
         (
             cPhysics & pI,
             cPhysics & pJ,
-            double odod, double nx, double ny,
-            double me,
-            double px, double py,
-            double & fx, double & fy
+            Real odod, Real nx, Real ny,
+            Real me,
+            Real px, Real py,
+            Real & fx, Real & fy
         );
 
-        void collisionForce
+        // a primitive's rectangle li against a wall's lj
+        void wallCollisionForce
         (
             cPhysics & pI, cPhysics & pJ,
             RectanglePrimitive * li,
-            RectanglePrimitive * lj,
-            bool wall = false
-        );
-
-        void collisionForce
-        (
-            cPhysics & pI, cPhysics & pJ,
-            CollisionPrimitive * c,
-            RectanglePrimitive * l,
-            double rx, double ry, double rc, double dd
-        );
-
-        void collisionForce
-        (
-            cPhysics & pI, cPhysics & pJ,
-            CollisionPrimitive * c,
-            CollisionPrimitive * l,
-            double rx, double ry, double rc, double dd
+            RectanglePrimitive * lj
         );
 
         bool handleObjectWorldCollision(
@@ -141,19 +139,20 @@ namespace Hop::System::Physics
         );
         
         void updateParameters(
-            double tc,
-            double cor
+            Real tc,
+            Real cor
         );
 
-        void setCoefRestitution(double cor){ return updateParameters(collisionTime, cor); }
-        void setSurfaceFriction(double f){ surfaceFriction = f; }
+        void setCoefRestitution(Real cor){ return updateParameters(collisionTime, cor); }
+        void setSurfaceFriction(Real f){ surfaceFriction = f; }
+        Real getCollisionTime() const { return collisionTime; }
 
         void tileCollision
         (
             Tile & h,
             double x0,
             double y0,
-            std::shared_ptr<CollisionPrimitive> c,
+            CollisionPrimitive * c,
             cPhysics & dataP,
             double & hx,
             double & hy,
@@ -167,7 +166,7 @@ namespace Hop::System::Physics
 
         void neighbourTilesCollision
         (
-            std::shared_ptr<CollisionPrimitive> c,
+            CollisionPrimitive * c,
             cPhysics & dataP,
             AbstractWorld * world,
             bool & collided
@@ -175,7 +174,7 @@ namespace Hop::System::Physics
 
         void tileBoundariesCollision
         (
-            std::shared_ptr<CollisionPrimitive> c,
+            CollisionPrimitive * c,
             cPhysics & dataP,
             TileWorld * world,
             bool & collided
@@ -183,7 +182,7 @@ namespace Hop::System::Physics
 
         bool tileBoundariesCollisionForce
         (
-            std::shared_ptr<CollisionPrimitive> c,
+            CollisionPrimitive * c,
             cPhysics & dataP,
             RectanglePrimitive * li,
             RectanglePrimitive r,
@@ -197,19 +196,145 @@ namespace Hop::System::Physics
 
         void hardBoundariesCollisionForce
         (
-            std::shared_ptr<CollisionPrimitive> c,
+            CollisionPrimitive * c,
             cPhysics & dataP,
-            Hop::World::FiniteBoundary<double> bounds,
+            const Hop::World::FiniteBoundary<double> & bounds,
             float lengthScale,
             bool & collided
         );
 
     private:
 
-        double collisionTime, coefficientOfRestitution;
+        Real collisionTime, coefficientOfRestitution;
 
         // pre-calculated collision parameters
-        double alpha, beta, surfaceFriction;
+        Real alpha, beta, surfaceFriction;
+
+        // the world last prepared, as its concrete type, and its hard boundary if any
+        AbstractWorld * preparedWorld = nullptr;
+        TileWorld * tileWorld = nullptr;
+        MarchingWorld * marchingWorld = nullptr;
+        Hop::World::FiniteBoundary<double> * hardBoundary = nullptr;
+
+        // for handleObjectObjectCollision
+        ContactBuffer immediate;
+
+        // one primitive of a pair, as its contacts record it
+        struct ContactSide
+        {
+            Id id;
+            uint64_t particle;
+            cPhysics * physics;
+            CollisionPrimitive * primitive;
+            bool soft;
+        };
+
+        /*
+            Record a's springDashpotForceRect contact onto b, with
+            (nx, ny) the normal from a to b, acting at (px, py).
+        */
+        void rectangleContact
+        (
+            ContactBuffer & contacts,
+            const ContactSide & a,
+            const ContactSide & b,
+            Real od, Real nx, Real ny,
+            Real me,
+            Real px, Real py,
+            bool primitives = true
+        );
+
+        /*
+            Contacts at a's corners inside b, or a's centre if none.
+            Only the last forces the primitives, and the centre
+            only if centrePrimitives.
+        */
+        void cornerContacts
+        (
+            ContactBuffer & contacts,
+            const ContactSide & a,
+            const ContactSide & b,
+            Real od, Real nx, Real ny,
+            Real me,
+            bool centrePrimitives
+        );
+
+        void circleContacts
+        (
+            ContactBuffer & contacts,
+            const ContactSide & i,
+            const ContactSide & j,
+            Real rc, Real dd
+        );
+
+        void circleRectangleContacts
+        (
+            ContactBuffer & contacts,
+            const ContactSide & c,
+            const ContactSide & l
+        );
+
+        void rectangleContacts
+        (
+            ContactBuffer & contacts,
+            const ContactSide & i,
+            const ContactSide & j
+        );
+
+        /*
+            Contacts between two overlapping primitives of types I
+            and J, the pair kernels are selected by type tags from
+            pairKernels.
+        */
+        template <PrimitiveType I, PrimitiveType J>
+        void pairContacts
+        (
+            ContactBuffer & contacts,
+            const ContactSide & i,
+            const ContactSide & j,
+            Real rc, Real dd
+        )
+        {
+            if constexpr (I == PrimitiveType::RECTANGLE && J == PrimitiveType::RECTANGLE)
+            {
+                rectangleContacts(contacts,i,j);
+            }
+            else if constexpr (I == PrimitiveType::RECTANGLE)
+            {
+                circleRectangleContacts(contacts,j,i);
+            }
+            else if constexpr (J == PrimitiveType::RECTANGLE)
+            {
+                circleRectangleContacts(contacts,i,j);
+            }
+            else
+            {
+                circleContacts(contacts,i,j,rc,dd);
+            }
+        }
+
+        typedef void (SpringDashpot::*PairKernel)
+        (
+            ContactBuffer &,
+            const ContactSide &,
+            const ContactSide &,
+            Real, Real
+        );
+
+        // indexed by the PrimitiveTypes of i and j
+        static const PairKernel pairKernels[2][2];
+    };
+
+    inline const SpringDashpot::PairKernel SpringDashpot::pairKernels[2][2] =
+    {
+        {
+            &SpringDashpot::pairContacts<PrimitiveType::CIRCLE, PrimitiveType::CIRCLE>,
+            &SpringDashpot::pairContacts<PrimitiveType::CIRCLE, PrimitiveType::RECTANGLE>
+        },
+        {
+            &SpringDashpot::pairContacts<PrimitiveType::RECTANGLE, PrimitiveType::CIRCLE>,
+            &SpringDashpot::pairContacts<PrimitiveType::RECTANGLE, PrimitiveType::RECTANGLE>
+        }
     };
 
 }
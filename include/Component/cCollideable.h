@@ -14,7 +14,7 @@ namespace Hop::Object::Component
 
         cCollideable
         (
-            std::vector<std::shared_ptr<CollisionPrimitive>> v,
+            std::vector<CollisionPrimitive> v,
             double x,
             double y, 
             double theta, 
@@ -32,15 +32,16 @@ namespace Hop::Object::Component
         void updateMesh(
             cTransform & transform,
             cPhysics & physics,
-            double dt
+            double dt,
+            unsigned subCycles = 1
         )
         {
-            mesh.updateWorldMesh(transform, physics, dt);
+            mesh.updateWorldMesh(transform, physics, dt, subCycles);
         }
 
         void add
         (
-            std::shared_ptr<CollisionPrimitive> c, 
+            const CollisionPrimitive & c, 
             cTransform & transform
         ) 
         { 
@@ -1,6 +1,10 @@
 #ifndef CPHYSICS_H
 #define CPHYSICS_H
 
+#include <cstdint>
+
+#include <Util/real.h>
+
 namespace Hop::Object::Component
 {
   /*
@@ -8,38 +12,43 @@ namespace Hop::Object::Component
       and moving.
   */
   
-  const double DEFAULT_MASS = 1.0;
-  const double DEFAULT_INTERTIA = 0.1;
-  const double DEFAULT_TRANSLATIONAL_DRAG = 0.0;
-  const double DEFAULT_ROTATIONAL_DRAG = 0.0;
+  const Real DEFAULT_MASS = 1.0;
+  const Real DEFAULT_INTERTIA = 0.1;
+  const Real DEFAULT_TRANSLATIONAL_DRAG = 0.0;
+  const Real DEFAULT_ROTATIONAL_DRAG = 0.0;
 
   struct cPhysics 
   {
-      double x, y;
-      double lastX;
-      double lastY;
-      double lastTheta;
+      Real x, y;
+      Real lastX;
+      Real lastY;
+      Real lastTheta;
 
-      double vx;
-      double vy;
-      double phi;
+      Real vx;
+      Real vy;
+      Real phi;
 
-      double momentOfInertia;
-      double mass;
+      Real momentOfInertia;
+      Real mass;
 
-      double fx;
-      double fy;
+      Real fx;
+      Real fy;
 
-      double omega, tau;
+      Real omega, tau;
 
-      double translationalDrag;
-      double rotationalDrag;
-      double friction;
+      Real translationalDrag;
+      Real rotationalDrag;
+      Real friction;
 
       bool isMoveable;
       bool isGhost;
 
-      cPhysics(double x, double y, double t)
+      // see sPhysics::setSleeping
+      bool isAsleep;
+      unsigned restingSteps;
+      uint64_t island;
+
+      cPhysics(Real x, Real y, Real t)
       : x(x), y(y), lastX(x), lastY(y), lastTheta(t),
         vx(0.0),vy(0.0),phi(0.0),momentOfInertia(DEFAULT_INTERTIA),
         mass(DEFAULT_MASS),
@@ -47,13 +56,16 @@ namespace Hop::Object::Component
         translationalDrag(DEFAULT_TRANSLATIONAL_DRAG), 
         rotationalDrag(DEFAULT_ROTATIONAL_DRAG),
         friction(0.0),
-        isMoveable(true)
+        isMoveable(true),
+        isAsleep(false),
+        restingSteps(0),
+        island(0)
       {}
 
       cPhysics
       (
-        double x, double y, double t, 
-        double td, double rd, double J, double m, double f
+        Real x, Real y, Real t, 
+        Real td, Real rd, Real J, Real m, Real f
       )
       : x(x), y(y), lastX(x), lastY(y), lastTheta(t),
         vx(0.0),vy(0.0),phi(0.0),momentOfInertia(J),
@@ -62,7 +74,10 @@ namespace Hop::Object::Component
         translationalDrag(td), rotationalDrag(rd),
         friction(f),
         isMoveable(true),
-        isGhost(false)
+        isGhost(false),
+        isAsleep(false),
+        restingSteps(0),
+        island(0)
       {}
 
       cPhysics() = default;
@@ -1,18 +1,20 @@
 #ifndef CTRANSFORM_H
 #define CTRANSFORM_H
 
+#include <Util/real.h>
+
 namespace Hop::Object::Component
 {
     struct cTransform {
-        double x, y, scale, theta;
+        Real x, y, scale, theta;
 
         cTransform() = default;
 
         cTransform(
-            double x,
-            double y,
-            double t,
-            double s
+            Real x,
+            Real y,
+            Real t,
+            Real s
         )
         : x(x), y(y), scale(s), theta(t)
         {}
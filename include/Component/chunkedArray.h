@@ -0,0 +1,98 @@
+#ifndef CHUNKEDARRAY_H
+#define CHUNKEDARRAY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Hop::Object::Component
+{
+
+    /*
+        An array grown a chunk at a time, so storage is only
+        allocated (and constructed) as elements are reached, and
+        elements never move once allocated.
+
+        Chunks hold a power of two elements, indexing is a shift
+        and a mask into the chunk table.
+    */
+    template <class T>
+    class ChunkedArray
+    {
+
+    public:
+
+        static constexpr uint64_t DEFAULT_CHUNK_SIZE = 1024;
+
+        // chunkSize is rounded up to a power of two
+        ChunkedArray(uint64_t chunkSize = DEFAULT_CHUNK_SIZE)
+        : shift(0)
+        {
+            while ((uint64_t(1) << shift) < chunkSize)
+            {
+                shift++;
+            }
+            mask = (uint64_t(1) << shift)-1;
+        }
+
+        ChunkedArray(const ChunkedArray<T> & a)
+        : shift(a.shift), mask(a.mask)
+        {
+            for (const std::unique_ptr<T[]> & c : a.chunks)
+            {
+                chunks.push_back(std::make_unique<T[]>(chunkSize()));
+                std::copy(c.get(), c.get()+chunkSize(), chunks.back().get());
+            }
+        }
+
+        ChunkedArray<T> & operator=(const ChunkedArray<T> & a)
+        {
+            *this = ChunkedArray<T>(a);
+            return *this;
+        }
+
+        ChunkedArray(ChunkedArray<T> && a) = default;
+        ChunkedArray<T> & operator=(ChunkedArray<T> && a) = default;
+
+        inline T & operator[](uint64_t k) { return chunks[k >> shift][k & mask]; }
+        inline const T & operator[](uint64_t k) const { return chunks[k >> shift][k & mask]; }
+
+        // allocates chunks until at least n elements are held
+        void reserve(uint64_t n)
+        {
+            while (capacity() < n)
+            {
+                chunks.push_back(std::make_unique<T[]>(chunkSize()));
+            }
+        }
+
+        // frees the chunks wholly past the first n elements
+        void shrink(uint64_t n)
+        {
+            uint64_t keep = (n+mask) >> shift;
+
+            while (chunks.size() > keep)
+            {
+                chunks.pop_back();
+            }
+        }
+
+        // elements from k to the end of its chunk, adjacent in memory
+        uint64_t contiguousFrom(uint64_t k) const { return chunkSize() - (k & mask); }
+
+        uint64_t capacity() const { return chunks.size() << shift; }
+        uint64_t chunkSize() const { return mask+1; }
+
+    private:
+
+        uint8_t shift;
+        uint64_t mask;
+
+        std::vector<std::unique_ptr<T[]>> chunks;
+
+    };
+
+}
+
+#endif /* CHUNKEDARRAY_H */
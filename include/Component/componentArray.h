@@ -6,8 +6,12 @@
 #include <sparsehash/dense_hash_map>
 #include <Component/cPhysics.h>
 #include <Component/cCollideable.h>
+#include <Component/chunkedArray.h>
 
 #include <limits>
+#include <string>
+#include <utility>
+#include <vector>
 
 using google::dense_hash_map;
 
@@ -19,8 +23,6 @@ namespace Hop::Object
 namespace Hop::Object::Component
 {
 
-    enum class REDUCTION_TYPE {SUM_EQUALS};
-
     class NoComponentForId: public std::exception 
     {
 
@@ -40,6 +42,25 @@ namespace Hop::Object::Component
         std::string msg;
     };
 
+    class ComponentArrayFull: public std::exception 
+    {
+
+    public:
+
+        ComponentArrayFull(std::string msg)
+        : msg(msg)
+        {}
+
+    private:
+
+        virtual const char * what() const throw()
+        {
+            return msg.c_str();
+        }
+        
+        std::string msg;
+    };
+
     class AbstractComponentArray 
     {
 
@@ -49,9 +70,14 @@ namespace Hop::Object::Component
         virtual void objectFreed(Id i) = 0;
         virtual void remove(Id & i) = 0;
 
+        // moves order[k]'s component to index k, order holding every Id
+        virtual void arrange(const std::vector<Id> & order) = 0;
+
         const uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max();
         const uint64_t DELETED_KEY = EMPTY_KEY-1; 
 
+        static constexpr uint64_t NO_INDEX = std::numeric_limits<uint64_t>::max();
+
     };
 
     template <class T>
@@ -60,34 +86,33 @@ namespace Hop::Object::Component
 
     public:
 
-        ComponentArray(uint64_t m)
-        : maxObjects(m), nextIndex(0)
+        /*
+            Holds at most m components, in chunks of chunkSize
+            allocated as they are reached (and freed as removals
+            leave them empty, keeping a chunk spare).
+        */
+        ComponentArray(uint64_t m, uint64_t chunkSize = ChunkedArray<T>::DEFAULT_CHUNK_SIZE)
+        : componentData(chunkSize), maxObjects(m), nextIndex(0)
         {
-            componentData = std::make_unique<T[]>(maxObjects);
             backBuffered = false;
             idToIndex.set_empty_key(EMPTY_KEY);
             idToIndex.set_deleted_key(DELETED_KEY);
-            indexToId.set_empty_key(Id(EMPTY_KEY));
-            indexToId.set_deleted_key(Id(DELETED_KEY));
         }
 
         ComponentArray(const ComponentArray<T> & a)
-        : maxObjects(a.maxObjects), nextIndex(a.nextIndex)
+        : componentData(a.componentData), maxObjects(a.maxObjects), nextIndex(a.nextIndex)
         {
-            this->componentData = std::make_unique<T[]>(maxObjects);
-
-            for (unsigned i = 0; i < nextIndex; i++)
-            {
-                this->componentData[i] = a.componentData[i];
-            }
-
+            this->backBuffered = a.backBuffered;
             this->idToIndex = a.idToIndex;
             this->indexToId = a.indexToId;
+            this->version = a.version;
         }
         
         void insert(Id & i, T component);
         void remove(Id & i);
 
+        void arrange(const std::vector<Id> & order);
+
         inline bool hasComponent(const Id & i) const
         {
             return idTaken(i);
@@ -101,59 +126,59 @@ namespace Hop::Object::Component
             return componentData[idToIndex[i]];
         }
 
-        inline T & get(const Id & i, const size_t worker)
-        {
-            // if (!idTaken(i)){
-            //     throw NoComponentForId("In ComponentArray.get(i)");
-            // }
-            return workerData[worker][idToIndex[i]];
-        }
+        /*
+            Dense access. Components sit contiguously at indices
+            [0, size()), in no particular order, and indices move
+            when a component is removed (the last fills its place),
+            or as archetype storage arranges them (see
+            EntityComponentSystem).
+        */
 
-        inline void objectFreed(Id i)
+        inline uint64_t size() const { return nextIndex; }
+
+        inline T & atIndex(uint64_t k) { return componentData[k]; }
+
+        // components from index k on that are adjacent in memory
+        inline uint64_t contiguousFrom(uint64_t k) const { return componentData.contiguousFrom(k); }
+
+        inline const Id & idAtIndex(uint64_t k) const { return indexToId[k]; }
+
+        // index of i's component, or NO_INDEX, in one lookup
+        inline uint64_t indexOf(const Id & i) const
         {
-            if (!idTaken(i))
-            {
-                return;
-            }
-            remove(i);
+            auto it = idToIndex.find(i);
+            return it == idToIndex.end() ? NO_INDEX : it->second;
         }
 
-        size_t allocatedWorkerData(){ return workerData.size(); }
+        // counts inserts and removes, so cached indices can be checked
+        inline uint64_t getVersion() const { return version; }
 
-        inline T * getWorkerData(size_t worker) { return workerData[worker].get(); }
-        inline dense_hash_map<Id,uint64_t> & getIdToIndex() { return idToIndex; }
-
-        inline void allocateWorkerData(size_t workers)
+        // f(id, component) for every component, in index order
+        template <class F>
+        void each(F f)
         {
-            if (workerData.size() != workers)
+            for (uint64_t k = 0; k < nextIndex; k++)
             {
-                workerData.clear();
-                for (unsigned i = 0; i < workers; i++)
-                {
-                    workerData.push_back
-                    (
-                        std::move
-                        (
-                            std::make_unique<T[]>(maxObjects)
-                        )
-                    );
-
-                }
+                f(indexToId[k], componentData[k]);
             }
         }
 
-        inline void scatter(size_t worker)
+        inline void objectFreed(Id i)
         {
-            unsigned start = std::floor(float(nextIndex)/float(workerData.size()))*worker;
-            unsigned idx = 0;
-            for (unsigned j = 0; j < nextIndex; j++)
-            {   
-                idx = (j+start) % nextIndex;
-                workerData[worker][idx] = componentData[idx];
+            if (!idTaken(i))
+            {
+                return;
             }
+            remove(i);
         }
 
-        inline void reduce(unsigned worker, REDUCTION_TYPE t = REDUCTION_TYPE::SUM_EQUALS);
+        // at most this many components are held
+        inline uint64_t getMaxObjects() const { return maxObjects; }
+
+        // components held before another chunk is allocated
+        inline uint64_t capacity() const { return componentData.capacity(); }
+
+        inline dense_hash_map<Id,uint64_t> & getIdToIndex() { return idToIndex; }
 
     protected:
 
@@ -162,15 +187,14 @@ namespace Hop::Object::Component
         bool idTaken(const Id & id) const {return idToIndex.find(id) != idToIndex.end();}
         bool backBuffered;
 
-        std::unique_ptr<T[]> componentData;
-
-        std::vector<std::unique_ptr<T[]>> workerData;
+        ChunkedArray<T> componentData;
 
         dense_hash_map<Id,uint64_t> idToIndex;
-        dense_hash_map<uint64_t,Id> indexToId;
+        std::vector<Id> indexToId;
 
-        uint32_t maxObjects;
+        uint64_t maxObjects;
         uint64_t nextIndex;
+        uint64_t version = 0;
 
     };
 
@@ -182,11 +206,18 @@ namespace Hop::Object::Component
             return;
         }
 
+        if (nextIndex >= maxObjects)
+        {
+            throw ComponentArrayFull("In ComponentArray.insert(i), at most "+std::to_string(maxObjects));
+        }
+
+        componentData.reserve(nextIndex+1);
         componentData[nextIndex] = component;
         idToIndex[i] = nextIndex;
-        indexToId[nextIndex] = i;
+        indexToId.push_back(i);
 
         nextIndex++;
+        version++;
     }
 
     template <class T>
@@ -201,20 +232,43 @@ namespace Hop::Object::Component
         if (index != nextIndex-1)
         {
             componentData[index] = componentData[nextIndex-1];
-            Id & moved = indexToId[nextIndex-1];
+            Id moved = indexToId[nextIndex-1];
             idToIndex[moved] = index;
             indexToId[index] = moved;
+        }
+        idToIndex.erase(i);
+        indexToId.pop_back();
+        nextIndex--;
+        version++;
 
-            indexToId.erase(nextIndex-1);
+        if ((nextIndex & (componentData.chunkSize()-1)) == 0)
+        {
+            componentData.shrink(nextIndex+componentData.chunkSize());
         }
-        else
+
+    }
+
+    template <class T>
+    void ComponentArray<T>::arrange(const std::vector<Id> & order)
+    {
+        for (uint64_t k = 0; k < order.size() && k < nextIndex; k++)
         {
-            idToIndex.erase(i);
-            indexToId.erase(index);
+            uint64_t j = idToIndex[order[k]];
+
+            if (j == k)
+            {
+                continue;
+            }
+
+            // order[0, k) are placed, so j > k
+            std::swap(componentData[k], componentData[j]);
+            indexToId[j] = indexToId[k];
+            indexToId[k] = order[k];
+            idToIndex[indexToId[j]] = j;
+            idToIndex[order[k]] = k;
         }
-        idToIndex.erase(i);
-        nextIndex--;
 
+        version++;
     }
 
 }
@@ -0,0 +1,225 @@
+#ifndef COMPONENTVIEW_H
+#define COMPONENTVIEW_H
+
+#include <Component/componentArray.h>
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Hop::Object::Component
+{
+
+    /*
+        Joined iteration over every object having all of the
+        components T..., e.g. for a system whose signature is T...
+
+            view.each([](const Id & id, cPhysics & p, cTransform & t){...});
+
+        The join is driven by the smallest array, walking it in
+        index order and looking each object up in the others once.
+        The resulting index columns are cached, and only rebuilt
+        when a component is inserted or removed (ComponentArray's
+        version), so steady state iteration is a linear walk with
+        no hashing.
+
+        Rows are in the driving array's index order, which is
+        creation order until components are removed.
+    */
+    template <class ... T>
+    class ComponentView
+    {
+
+    public:
+
+        static constexpr size_t N = sizeof...(T);
+        static constexpr uint64_t NO_INDEX = AbstractComponentArray::NO_INDEX;
+
+        ComponentView(ComponentArray<T> & ... a)
+        : arrays(&a...)
+        {
+            versions.fill(NO_INDEX);
+        }
+
+        // f(id, T & ...) for every object with all of T...
+        template <class F>
+        void each(F f)
+        {
+            refresh();
+            each(f, std::index_sequence_for<T...>());
+        }
+
+        // number of objects with all of T...
+        size_t size()
+        {
+            refresh();
+            return ids.size();
+        }
+
+        // the joined objects, in iteration order
+        const std::vector<Id> & getIds()
+        {
+            refresh();
+            return ids;
+        }
+
+        // index column of O, one of T..., as each visits them
+        template <class O>
+        const std::vector<uint64_t> & indices()
+        {
+            static_assert(position<O>() < N, "O must be joined");
+            refresh();
+            return columns[position<O>()];
+        }
+
+        /*
+            Index column of a component O the joined objects may not
+            have, row by row as each visits them, NO_INDEX where an
+            object has none. Cached as the join is.
+        */
+        template <class O>
+        const std::vector<uint64_t> & optional(ComponentArray<O> & a)
+        {
+            refresh();
+
+            Optional & o = optionals[&a];
+
+            if (o.generation != generation || o.version != a.getVersion())
+            {
+                o.generation = generation;
+                o.version = a.getVersion();
+                o.column.resize(ids.size());
+
+                for (size_t r = 0; r < ids.size(); r++)
+                {
+                    o.column[r] = a.indexOf(ids[r]);
+                }
+            }
+
+            return o.column;
+        }
+
+    private:
+
+        struct Optional
+        {
+            uint64_t generation = 0;
+            uint64_t version = NO_INDEX;
+            std::vector<uint64_t> column;
+        };
+
+        // counts rebuilds of the join, invalidating optional columns
+        uint64_t generation = 0;
+        std::unordered_map<const AbstractComponentArray *, Optional> optionals;
+
+        std::tuple<ComponentArray<T> * ...> arrays;
+
+        std::array<uint64_t, N> versions;
+
+        std::vector<Id> ids;
+        std::array<std::vector<uint64_t>, N> columns;
+
+        template <class O>
+        static constexpr size_t position()
+        {
+            size_t k = 0, p = N;
+            ((p = (p == N && std::is_same_v<O, T>) ? k : p, k++), ...);
+            return p;
+        }
+
+        template <class F, size_t ... I>
+        void each(F & f, std::index_sequence<I...>)
+        {
+            for (size_t r = 0; r < ids.size(); r++)
+            {
+                f(ids[r], std::get<I>(arrays)->atIndex(columns[I][r])...);
+            }
+        }
+
+        template <size_t ... I>
+        std::array<uint64_t, N> currentVersions(std::index_sequence<I...>) const
+        {
+            return {std::get<I>(arrays)->getVersion()...};
+        }
+
+        template <size_t ... I>
+        std::array<uint64_t, N> sizes(std::index_sequence<I...>) const
+        {
+            return {std::get<I>(arrays)->size()...};
+        }
+
+        template <size_t ... I>
+        std::array<uint64_t, N> lookup(const Id & id, std::index_sequence<I...>) const
+        {
+            return {std::get<I>(arrays)->indexOf(id)...};
+        }
+
+        template <size_t ... I>
+        const Id & idAt(size_t a, uint64_t k, std::index_sequence<I...>) const
+        {
+            const Id * id = nullptr;
+            ((id = (a == I ? &std::get<I>(arrays)->idAtIndex(k) : id)), ...);
+            return *id;
+        }
+
+        void refresh()
+        {
+            std::array<uint64_t, N> current = currentVersions(std::index_sequence_for<T...>());
+
+            if (current == versions)
+            {
+                return;
+            }
+
+            versions = current;
+            generation++;
+
+            ids.clear();
+            for (std::vector<uint64_t> & c : columns)
+            {
+                c.clear();
+            }
+
+            // the smallest array drives, the rest are looked up
+
+            std::array<uint64_t, N> n = sizes(std::index_sequence_for<T...>());
+
+            size_t driver = 0;
+            for (size_t a = 1; a < N; a++)
+            {
+                driver = n[a] < n[driver] ? a : driver;
+            }
+
+            for (uint64_t k = 0; k < n[driver]; k++)
+            {
+                const Id & id = idAt(driver, k, std::index_sequence_for<T...>());
+
+                std::array<uint64_t, N> row = lookup(id, std::index_sequence_for<T...>());
+
+                bool joined = true;
+                for (uint64_t r : row)
+                {
+                    joined = joined && r != NO_INDEX;
+                }
+
+                if (!joined)
+                {
+                    continue;
+                }
+
+                ids.push_back(id);
+                for (size_t a = 0; a < N; a++)
+                {
+                    columns[a].push_back(row[a]);
+                }
+            }
+        }
+
+    };
+
+}
+
+#endif /* COMPONENTVIEW_H */
@@ -10,6 +10,7 @@
 #include <Console/LuaBool.h>
 #include <System/Physics/sPhysics.h>
 #include <System/Physics/sCollision.h>
+#include <Collision/neighbourList.h>
 #include <jLog/jLog.h>
 #include <Object/id.h>
 #include <Console/scriptz.h>
@@ -110,6 +111,8 @@ namespace Hop
 
     int lua_applyForce(lua_State * lua);
 
+    int lua_setCollisionDetector(lua_State * lua);
+
     class Console 
     {
     public:
@@ -299,7 +302,7 @@ namespace Hop
 
         static int load_hopLib(lua_State * lua)
         {
-            luaL_Reg hopLib[21] =
+            luaL_Reg hopLib[26] =
             {
                 {"loadObject", &dispatchEntityComponentSystem<&EntityComponentSystem::lua_loadObject>},
                 {"deleteObject", &dispatchEntityComponentSystem<&EntityComponentSystem::lua_deleteObject>},
@@ -315,11 +318,16 @@ namespace Hop
                 ///////////////////////////////////////////////////////////////////////////////////////////
                 {"setPhysicsTimeStep",&dispatchsPhysics<&sPhysics::lua_setTimeStep>},
                 {"setPhysicsSubSamples",&dispatchsPhysics<&sPhysics::lua_setSubSamples>},
+                {"setSoftBodySubCycles",&dispatchsPhysics<&sPhysics::lua_setSoftBodySubCycles>},
                 {"kineticEnergy", &dispatchsPhysics<&sPhysics::lua_kineticEnergy>},
                 {"setGravity", &dispatchsPhysics<&sPhysics::lua_setGravity>},
+                {"setSleeping", &dispatchsPhysics<&sPhysics::lua_setSleeping>},
+                {"setAdaptiveTimeStep", &dispatchsPhysics<&sPhysics::lua_setAdaptive>},
+                {"physicsTimeStep", &dispatchsPhysics<&sPhysics::lua_timeStep>},
                 ///////////////////////////////////////////////////////////////////
                 {"setCoefRestitution",&dispatchsCollision<&sCollision::lua_setCOR>},
                 {"setSurfaceFriction",&dispatchsCollision<&sCollision::lua_setFriction>},
+                {"setCollisionDetector", &lua_setCollisionDetector},
                 ////////////////////////////////////////////////////////////////////
                 {"configure", &configure},
                 {"timeMillis", &timeMillis},
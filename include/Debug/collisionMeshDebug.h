@@ -19,6 +19,7 @@ namespace Hop::Object
 namespace Hop::Debugging
 {
     using Hop::Object::EntityComponentSystem;
+    using Hop::Object::Id;
     using Hop::Object::Component::cCollideable;
     using Hop::System::Physics::CollisionPrimitive;
     using Hop::System::Physics::MeshPoint;
@@ -22,11 +22,18 @@
 #include <map>
 #include <string>
 #include <iterator>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
 
-#include <typeinfo>
 #include <exception>
 
 #include <Component/componentArray.h>
+#include <Component/componentView.h>
+#include <Util/typeIndex.h>
 
 #include <Console/lua.h>
 
@@ -87,18 +94,36 @@ namespace Hop::Object
     typedef void (*CollisionCallback)(Id & i, Id & j);
     void identityCallback(Id & i, Id & j);
 
+    // default limit on objects holding any one component
     const uint32_t MAX_OBJECTS = 100000;
 
+    /*
+        How components are laid out. COMPONENT_ARRAYS keeps each
+        type's array in insertion order (less swaps on removal).
+        ARCHETYPES groups objects with the same signature so that,
+        in each of their component arrays, they are a block of
+        adjacent indices in the same order, walked by eachChunk.
+    */
+    enum class Storage {COMPONENT_ARRAYS, ARCHETYPES};
+
     class EntityComponentSystem 
     {
 
     public:
 
+        /*
+            maxObjects limits the components of each type held,
+            storage grows to it a chunk at a time as objects are
+            added, see ComponentArray.
+        */
         EntityComponentSystem(
-            void (*callback)(Id & i, Id & j) = &identityCallback
+            void (*callback)(Id & i, Id & j) = &identityCallback,
+            uint64_t maxObjects = MAX_OBJECTS,
+            Storage storage = Storage::COMPONENT_ARRAYS
         )
-        : collisionCallback(callback), 
-        nextComponentIndex(0)
+        : collisionCallback(callback),
+        maxObjects(maxObjects),
+        storage(storage)
         {
             initialiseBaseECS();
             objects.clear();
@@ -119,91 +144,98 @@ namespace Hop::Object
 
         const std::unordered_map<Id,std::shared_ptr<Object>> & getObjects() { return objects; }
 
+        uint64_t getMaxObjects() const { return maxObjects; }
+
+        Storage getStorage() const { return storage; }
+
         CollisionCallback collisionCallback;
 
-        // component interface
+        /*
+            Component interface. A component type's id is its
+            TypeIndex, fixed for the process at first use, and
+            indexes both the component arrays and the signature
+            bits, so lookups by type are a load rather than hashing
+            typeid(T).name().
+        */
 
         template <class T>
         void registerComponent()
         {
-            const char * handle = typeid(T).name();
-
-            if (componentRegistered(handle))
-            {
-                return;
-            }
+            uint32_t c = getComponentId<T>();
 
-            if (nextComponentIndex >= MAX_COMPONENTS)
+            if (c >= MAX_COMPONENTS || componentData[c] != nullptr)
             {
                 return;
             }
 
-            registeredComponents[handle] = nextComponentIndex;
-            nextComponentIndex++;
-            componentData[handle] = std::make_shared<ComponentArray<T>>(MAX_OBJECTS);
-            
+            componentData[c] = std::make_shared<ComponentArray<T>>(maxObjects);
         }
 
         template <class T>
         void addComponent(Id i, T component)
         {
-            const char * handle = typeid(T).name();
-
-            if (!componentRegistered(handle))
+            if (!componentRegistered<T>())
             {
                 return;
             }
 
             getComponentArray<T>().insert(i,component);
-            idToSignature[i].set(
+            Signature & s = record(i).signature;
+            Signature was = s;
+            s.set(
                 getComponentId<T>(),
                 true
             );
-            systemManager.objectSignatureChanged(i,idToSignature[i]);
+            changeArchetype(i,was,s);
+            systemManager.objectSignatureChanged(i,s);
         }
 
         template <class T>
         void removeComponent(Id i)
         {
-            const char * handle = typeid(T).name();
-
-            if (!componentRegistered(handle))
+            if (!componentRegistered<T>())
             {
                 return;
             }
 
             getComponentArray<T>().remove(i);
-            idToSignature[i].set(
+            Signature & s = record(i).signature;
+            Signature was = s;
+            s.set(
                 getComponentId<T>(),
                 false
             );
-            systemManager.objectSignatureChanged(i,idToSignature[i]);
+            changeArchetype(i,was,s);
+            systemManager.objectSignatureChanged(i,s);
         }
 
         template <class T>
         inline T & getComponent(const Id & i)
         {
-            const char * handle = typeid(T).name();
-
-            // if (!componentRegistered(handle)){
+            // if (!componentRegistered<T>()){
             //     throw ComponentNotRegistered(" Attempt to getComponent<"+i.idStr+")");
             // }
-            return (std::static_pointer_cast<ComponentArray<T>>(componentData[handle]))->get(i);
+            return getComponentArray<T>().get(i);
         }
 
         void objectFreed(Id i)
         {
-            for (auto const& pair : componentData)
+            for (auto const & array : componentData)
             {
-                pair.second.get()->objectFreed(i);
+                if (array != nullptr)
+                {
+                    array->objectFreed(i);
+                }
             }
+            Signature & s = record(i).signature;
+            changeArchetype(i,s,Signature());
+            s = Signature();
         }
 
         template <class T>
         uint32_t getComponentId()
         {
-            const char * handle = typeid(T).name();
-            return registeredComponents[handle];
+            return ComponentTypes::of<T>();
         }
 
         // system interface
@@ -217,26 +249,98 @@ namespace Hop::Object
         T & getSystem(){return systemManager.getSystem<T>();}
 
         template<class T>
-        bool hasComponent(const Id & i){return idToSignature[i][getComponentId<T>()];}
+        bool hasComponent(const Id & i)
+        {
+            uint64_t page = i.id / SIGNATURE_PAGE_SIZE;
+            uint32_t c = getComponentId<T>();
+
+            return c < MAX_COMPONENTS
+                && page < records.size()
+                && !records[page].empty()
+                && records[page][i.id % SIGNATURE_PAGE_SIZE].signature[c];
+        }
 
         template <class T>
         ComponentArray<T> getComponentArrayCopy()
         {
-            const char * handle = typeid(T).name();
-
-            return *(std::static_pointer_cast<ComponentArray<T>>(componentData[handle]));
-
+            return getComponentArray<T>();
         }
 
         template <class T>
         ComponentArray<T> & getComponentArray()
         {
-            const char * handle = typeid(T).name();
+            return *static_cast<ComponentArray<T>*>(componentData[getComponentId<T>()].get());
+        }
+
+        /*
+            Joined view of the objects with all of T..., see
+            ComponentView. Views are cached, so their index
+            columns persist between calls.
+        */
+        template <class ... T>
+        ComponentView<T...> & view()
+        {
+            uint32_t v = ViewTypes::of<ComponentView<T...>>();
+
+            if (v >= views.size())
+            {
+                views.resize(v+1);
+            }
+
+            if (views[v] == nullptr)
+            {
+                views[v] = std::make_shared<ComponentView<T...>>(getComponentArray<T>()...);
+            }
+
+            return *static_cast<ComponentView<T...>*>(views[v].get());
+        }
+
+        /*
+            f(n, ids, T * ...) over runs of n objects having all of
+            T..., whose components lie adjacent in each array, e.g.
+
+                eachChunk<cPhysics, cTransform>
+                (
+                    [](size_t n, const Id * ids, cPhysics * p, cTransform * t)
+                    {
+                        for (size_t k = 0; k < n; k++) { ... p[k] ... t[k] ... }
+                    }
+                );
+
+            With ARCHETYPES storage each matching archetype's block
+            is a run (split where a storage chunk ends), arranging
+            any arrays objects have since moved in or out of first.
+            Otherwise runs are single objects in view<T...>() order.
+        */
+        template <class ... T, class F>
+        void eachChunk(F f)
+        {
+            if (storage != Storage::ARCHETYPES)
+            {
+                view<T...>().each
+                (
+                    [&f](const Id & id, T & ... c)
+                    {
+                        f(size_t(1), &id, &c...);
+                    }
+                );
+                return;
+            }
 
-            return *(std::static_pointer_cast<ComponentArray<T>>(componentData[handle]));
+            arrange();
 
+            archetypeChunks<T...>(f, std::index_sequence_for<T...>());
         }
 
+        /*
+            With ARCHETYPES storage, put the arrays objects have
+            moved in or out of back in archetype order. Views then
+            walk each archetype's block in turn, so systems call
+            this before a step's views and eachChunk (sPhysics::step
+            does), which all then share one order.
+        */
+        void arrange();
+
         template <class T>
         void updateMainComponents();
 
@@ -259,22 +363,129 @@ namespace Hop::Object
     private:
 
         std::unordered_map<std::string,Id> handleToId;
-        std::unordered_map<Id,Signature> idToSignature;
         std::unordered_map<Id,std::shared_ptr<Object>> objects;
 
+        uint64_t maxObjects;
+
+        /*
+            Signatures (and archetype rows) indexed by Id, Ids being
+            sequential, in pages allocated as Ids reach them (Ids are
+            shared by every EntityComponentSystem so another's need
+            no storage).
+        */
+        struct Record
+        {
+            Signature signature;
+            uint64_t row = 0;
+        };
+
+        static constexpr uint64_t SIGNATURE_PAGE_SIZE = 4096;
+        std::vector<std::vector<Record>> records;
+
+        Record & record(const Id & i)
+        {
+            uint64_t page = i.id / SIGNATURE_PAGE_SIZE;
+
+            if (page >= records.size())
+            {
+                records.resize(page+1);
+            }
+
+            if (records[page].empty())
+            {
+                records[page].resize(SIGNATURE_PAGE_SIZE);
+            }
+
+            return records[page][i.id % SIGNATURE_PAGE_SIZE];
+        }
+
+        Storage storage;
+
+        /*
+            Archetype storage. An archetype's ids give its objects'
+            order, and each component array lists the archetypes
+            with that component, their blocks following one another
+            in that order. Moving objects between archetypes only
+            marks the arrays involved as unarranged, they are put
+            back in order, O(size), by the next arrange.
+        */
+        struct Archetype
+        {
+            Signature signature;
+            std::vector<Id> ids;
+            // index of its block in each array, set by arrange
+            std::array<uint64_t, MAX_COMPONENTS> start = {};
+        };
+
+        static constexpr uint32_t NO_ARCHETYPE = std::numeric_limits<uint32_t>::max();
+
+        std::vector<Archetype> archetypes;
+        std::unordered_map<Signature, uint32_t> archetypeIndex;
+        std::array<std::vector<uint32_t>, MAX_COMPONENTS> blocks;
+        Signature unarranged;
+        std::vector<Id> order;
+
+        // an object's signature changed from was to is
+        void changeArchetype(const Id & i, const Signature & was, const Signature & is);
+        uint32_t getArchetype(const Signature & s);
+
+        template <class ... T, class F, size_t ... I>
+        void archetypeChunks(F & f, std::index_sequence<I...>)
+        {
+            std::tuple<ComponentArray<T> & ...> arrays(getComponentArray<T>()...);
+
+            Signature query;
+            (query.set(getComponentId<T>()), ...);
+
+            for (uint32_t a = 0; a < archetypes.size(); a++)
+            {
+                const Archetype & archetype = archetypes[a];
+
+                if ((archetype.signature & query) != query || archetype.ids.empty())
+                {
+                    continue;
+                }
+
+                std::array<uint64_t, sizeof...(T)> start = {archetype.start[getComponentId<T>()]...};
+
+                uint64_t n = archetype.ids.size();
+                uint64_t r = 0;
+
+                while (r < n)
+                {
+                    // up to the first storage chunk to end
+                    uint64_t run = n-r;
+                    ((run = std::min(run, std::get<I>(arrays).contiguousFrom(start[I]+r))), ...);
+
+                    f(size_t(run), &archetype.ids[r], &std::get<I>(arrays).atIndex(start[I]+r)...);
+
+                    r += run;
+                }
+            }
+        }
+
         SystemManager systemManager;
 
         void initialiseBaseECS();
 
         // components
 
-        bool componentRegistered(const char * h){return registeredComponents.find(h)!=registeredComponents.end();}
+        struct Components;
+        struct Views;
 
-        uint32_t nextComponentIndex;
+        typedef Hop::Util::TypeIndex<Components> ComponentTypes;
+        typedef Hop::Util::TypeIndex<Views> ViewTypes;
+
+        template <class T>
+        bool componentRegistered()
+        {
+            uint32_t c = getComponentId<T>();
+            return c < MAX_COMPONENTS && componentData[c] != nullptr;
+        }
 
-        std::unordered_map<const char *, uint32_t> registeredComponents;
+        std::array<std::shared_ptr<AbstractComponentArray>, MAX_COMPONENTS> componentData;
 
-        std::unordered_map<const char *, std::shared_ptr<AbstractComponentArray>> componentData;
+        std::vector<std::shared_ptr<void>> views;
 
     };
 }
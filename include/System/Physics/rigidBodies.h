@@ -0,0 +1,74 @@
+#ifndef RIGIDBODIES_H
+#define RIGIDBODIES_H
+
+#include <vector>
+#include <cstddef>
+
+#include <Component/cPhysics.h>
+#include <Component/cTransform.h>
+#include <Util/real.h>
+
+namespace Hop::System::Physics
+{
+
+    using Hop::Object::Component::cPhysics;
+    using Hop::Object::Component::cTransform;
+    using Hop::Real;
+
+    /*
+        The translational step of the moveable rigid bodies,
+        vectorised.
+
+        Bodies are set each step, then integrate gathers them
+        Lanes::width at a time from their components into packed
+        (structure of arrays) lanes, steps them, and scatters them
+        back. Lanes live only as long as the step of their bodies,
+        so nothing goes stale when components are written between
+        steps, and their components are read and written once.
+    */
+    class RigidBodies
+    {
+
+    public:
+
+        RigidBodies(){}
+
+        void clear();
+
+        void resize(size_t n);
+
+        size_t size() const { return transforms.size(); }
+
+        // body i's components
+        void set(size_t i, cTransform * transform, cPhysics * physics)
+        {
+            transforms[i] = transform;
+            this->physics[i] = physics;
+        }
+
+        /*
+            Drag corrected Verlet step (see sPhysics::update) for the
+            bodies [begin, end), over Lanes (Util/lanes.h) then a
+            Lane at a time for the tail. Writes their positions and
+            velocities, and zeros their forces.
+        */
+        void integrate
+        (
+            Real dt,
+            Real dtdt,
+            size_t begin,
+            size_t end
+        );
+
+        void integrate(Real dt, Real dtdt) { integrate(dt, dtdt, 0, size()); }
+
+    private:
+
+        std::vector<cTransform*> transforms;
+        std::vector<cPhysics*> physics;
+
+    };
+
+}
+
+#endif /* RIGIDBODIES_H */
@@ -51,8 +51,13 @@ namespace Hop::System::Physics
             resolver = std::move(r);
         }
 
-        std::pair<std::multimap<Id, CollisionDetector::CollisionType>::iterator, std::multimap<Id, CollisionDetector::CollisionType>::iterator> objectCollisions(Id & id) { return detector->objectCollisions(id); }
+        std::pair<CollisionLog::const_iterator, CollisionLog::const_iterator> objectCollisions(Id & id) { return detector->objectCollisions(id); }
         bool objectHasCollided(Id & id) { return detector->objectHasCollided(id); }
+        const CollisionLog & getCollisions() const { return detector->getCollisions(); }
+        const ContactBuffer & getContacts() const { return detector->getContacts(); }
+
+        const PhysicsTimings & getTimings() const { return detector->getTimings(); }
+        void resetTimings() { detector->resetTimings(); }
 
         void centreOn(std::pair<float,float> p){centreOn(p.first,p.second);}
 
@@ -60,6 +65,7 @@ namespace Hop::System::Physics
 
         void setCoefRestitution(double cor){ resolver->setCoefRestitution(cor); }
         void setSurfaceFriction(double f) { resolver->setSurfaceFriction(f); }
+        Real getCollisionTime() const { return resolver->getCollisionTime(); }
 
         int lua_setCOR(lua_State * lua)
         {  
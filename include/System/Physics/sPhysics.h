@@ -5,10 +5,19 @@
 #include <Component/cPhysics.h>
 #include <Maths/special.h>
 #include <Component/componentArray.h>
+#include <Component/componentView.h>
 #include <System/Physics/sCollision.h>
+#include <System/Physics/rigidBodies.h>
 #include <World/world.h>
 #include <Console/lua.h>
 
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <unordered_map>
+
 namespace Hop::Object
 {
     class EntityComponentSystem;
@@ -22,12 +31,33 @@ namespace Hop::System::Physics
 
     using Hop::Object::EntityComponentSystem;
     using Hop::Object::Component::ComponentArray;
+    using Hop::Object::Component::ComponentView;
     using Hop::Object::Component::cPhysics;
     using Hop::Object::Component::cCollideable;
     using Hop::Object::Component::cTransform;
     using Hop::System::Physics::sCollision;
     using Hop::World::AbstractWorld;
 
+    /*
+        Limits of sPhysics' adaptive time step. Each step advances
+        frameTime in the fewest sub steps (at most maxSubSamples)
+        for which no primitive moves further than maxMovement of
+        its radius, and the resolver's collision time and the
+        stiffest soft mesh spring (over its sub cycles) each span
+        stepsPerCollision sub steps. A positive budget, wall clock
+        seconds per step, also caps sub steps by their measured
+        cost. Capped steps keep the stable time step, simulating
+        less than frameTime rather than going unstable.
+    */
+    struct AdaptiveTimeStep
+    {
+        Real frameTime = 1.0/900.0;
+        unsigned maxSubSamples = 64;
+        double budget = 0.0;
+        Real maxMovement = 1.0;
+        Real stepsPerCollision = 10.0;
+    };
+
     /*
         System to update cPhysics components given forces
     */
@@ -42,21 +72,25 @@ namespace Hop::System::Physics
           gravity(9.81),
           ngx(0.0),
           ngy(-1.0),
-          subSamples(1)
+          subSamples(1),
+          sleeping(false),
+          sleepEnergy(1e-4),
+          sleepSteps(90)
         {}
 
         void step
         (
             EntityComponentSystem * m, 
             sCollision * collisions,
-            AbstractWorld * world
+            AbstractWorld * world,
+            ThreadPool * workers = nullptr
         );
 
         void setGravityForce
         (
-            double g,
-            double nx,
-            double ny
+            Real g,
+            Real nx,
+            Real ny
         )
         {
             gravity = g;
@@ -67,24 +101,43 @@ namespace Hop::System::Physics
         void applyForce(
             EntityComponentSystem * m,
             Id & i,
-            double fx,
-            double fy,
+            Real fx,
+            Real fy,
             bool global = false
         );
 
         void applyTorque(
             EntityComponentSystem * m,
             Id & i,
-            double tau
+            Real tau
         );
 
         void applyForce(
             EntityComponentSystem * m,
-            double fx,
-            double fy,
+            Real fx,
+            Real fy,
             bool global = false
         );
 
+        /*
+            Rigid bodies whose kinetic energy per unit mass stays 
+            below energy for steps steps are put to sleep, together
+            with every body they touch (an island). Sleeping bodies 
+            are not integrated, and only collide with awake bodies.
+            An island wakes when a moving body hits it, or on wake.
+        */
+        void setSleeping(bool s, Real energy, unsigned steps)
+        {
+            sleeping = s;
+            sleepEnergy = energy;
+            sleepSteps = steps;
+        }
+
+        bool getSleeping() const { return sleeping; }
+
+        // wake i's island, and restart i's count of resting steps
+        void wake(EntityComponentSystem * m, const Id & i);
+
         // automatically compute stable simulation parameters
         // updating all objects
         void stabaliseObjectParameters(Hop::Object::EntityComponentSystem * m);
@@ -105,7 +158,7 @@ namespace Hop::System::Physics
                 return lua_error(lua);
             }
 
-            double delta = lua_tonumber(lua, 1);
+            Real delta = lua_tonumber(lua, 1);
             setTimeStep(delta);
 
             return 0;
@@ -133,6 +186,28 @@ namespace Hop::System::Physics
             return 0;
         }
 
+        int lua_setSoftBodySubCycles(lua_State * lua)
+        {   
+            int n = lua_gettop(lua);
+            
+            if (n != 1)
+            {
+                lua_pushliteral(lua, "requires 1 argument, subcycles");
+                return lua_error(lua);
+            }
+
+            if (!lua_isinteger(lua, 1) || lua_tointeger(lua, 1) < 1)
+            {
+                lua_pushliteral(lua, "requires a positive integer argument for subcycles");
+                return lua_error(lua);
+            }
+
+            unsigned subCycles = lua_tointeger(lua, 1);
+            setSoftBodySubCycles(subCycles);
+
+            return 0;
+        }
+
         double kineticEnergy()
         {
             return energy;
@@ -144,44 +219,171 @@ namespace Hop::System::Physics
             return 1;
         }
         
-        void setTimeStep(double delta){dt = delta; dtdt = dt*dt;}
-        double getTimeStep() const { return dt; }
+        void setTimeStep(Real delta){dt = delta; dtdt = dt*dt;}
+        Real getTimeStep() const { return dt; }
 
         void setSubSamples(unsigned s){subSamples = s;}
         unsigned getSubSamples() const { return subSamples; }
 
-        void setGravity(double g, double nx, double ny){gravity = g; ngx = nx; ngy = ny;}
-        double getGravity() const { return gravity; }
+        /*
+            Soft meshes' internal springs take k steps of timestep / k
+            per (sub) step, with collision forces held, so stiff soft
+            bodies may run fewer, longer, collision steps.
+        */
+        void setSoftBodySubCycles(unsigned k){softBodySubCycles = std::max(k, 1u);}
+        unsigned getSoftBodySubCycles() const { return softBodySubCycles; }
+
+        /*
+            Choose the time step and sub samples each step, see
+            AdaptiveTimeStep. Enabling without limits keeps the
+            current frame time, timestep * subsamples. Deterministic
+            unless a budget is set.
+        */
+        void setAdaptive(bool a)
+        {
+            AdaptiveTimeStep l = limits;
+            l.frameTime = dt*subSamples;
+            setAdaptive(a, l);
+        }
+
+        void setAdaptive(bool a, AdaptiveTimeStep l)
+        {
+            adaptive = a;
+            limits = l;
+            subStepCost = 0.0;
+        }
+
+        bool getAdaptive() const { return adaptive; }
+        const AdaptiveTimeStep & getAdaptiveLimits() const { return limits; }
+
+        // the largest stable time step at the last adaptive step
+        Real getStableTimeStep() const { return stableDt; }
+
+        // mean wall clock seconds per sub step, measured with a budget
+        double getSubStepCost() const { return subStepCost; }
+
+        // integration time (BENCHMARK builds)
+        const PhysicsTimings & getTimings() const { return timings; }
+        void resetTimings() { timings = PhysicsTimings(); }
+
+        void setGravity(Real g, Real nx, Real ny){gravity = g; ngx = nx; ngy = ny;}
+        Real getGravity() const { return gravity; }
         glm::vec2 getGravityDirection() const { return glm::vec2(ngx, ngy); }
 
         // Lua 
 
         int lua_setGravity(lua_State * lua);
+
+        int lua_setSleeping(lua_State * lua);
+
+        int lua_setAdaptive(lua_State * lua);
+
+        int lua_timeStep(lua_State * lua);
         
     private:
 
         void update(EntityComponentSystem * m, ThreadPool * workers = nullptr);
 
+        // integrate and update meshes for bodies in chunk c
+        void updateChunk(size_t c);
+
+        // rebuild bodies from m
+        void gatherBodies(EntityComponentSystem * m);
+
         void gravityForce
         (
             EntityComponentSystem * m
         );
 
+        static constexpr size_t UPDATE_CHUNK_SIZE = 256;
+        static constexpr size_t NO_LANE = std::numeric_limits<size_t>::max();
+
+        // wake islands touched by a moving body
+        void wakeOnContact(EntityComponentSystem * m, sCollision * collisions);
+
+        // sleep islands whose bodies have all rested long enough
+        void sleepIslands(sCollision * collisions);
+
+        // largest time step keeping every moving body stable
+        Real stableTimeStep(EntityComponentSystem * m, sCollision * collisions);
+
+        // set dt and subSamples for the next adaptive step
+        void chooseTimeStep(EntityComponentSystem * m, sCollision * collisions);
+
+        // keep velocities when dt changes by ratio
+        void rescaleTimeStep(EntityComponentSystem * m, Real ratio);
+
+        struct Body
+        {
+            Id id;
+            cTransform * transform;
+            cPhysics * physics;
+            cCollideable * collideable;
+            // index into rigidBodies this step, if a moveable rigid body
+            size_t lane;
+        };
+
+        PhysicsTimings timings;
+        PhaseClock clock;
+
+        /*
+            Awake bodies, and the sleeping bodies' physics. Gathered
+            when islands sleep or wake, or when the arrays they point
+            into have changed since (by version). rigidBodies has a
+            slot per body, set each step by updateChunk.
+        */
+        std::vector<Body> bodies;
+        RigidBodies rigidBodies;
+        std::vector<cPhysics*> sleepers;
+
+        bool bodiesStale = true;
+        const EntityComponentSystem * bodiesOf = nullptr;
+        std::array<uint64_t, 3> bodyVersions;
+        std::vector<double> chunkEnergy;
+
+        // members of each sleeping island, and free slots
+        std::vector<std::vector<Id>> islands;
+        std::vector<uint64_t> freeIslands;
+
+        // union find over bodies for sleepIslands
+        std::unordered_map<Id, size_t> bodyIndex;
+        std::vector<size_t> parent;
+        std::vector<bool> canSleep;
+
+        size_t root(size_t i)
+        {
+            while (parent[i] != i)
+            {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+
         std::default_random_engine e;
-        std::normal_distribution<double> normal;
+        std::normal_distribution<Real> normal;
 
-        double dt;
-        double dtdt;
-        double gravity, ngx, ngy;
-        double movementLimitRadii = 0.33;
+        Real dt;
+        Real dtdt;
+        Real gravity, ngx, ngy;
         unsigned subSamples;
+        unsigned softBodySubCycles = 1;
         double energy = 0.0;
 
+        bool adaptive = false;
+        AdaptiveTimeStep limits;
+        Real stableDt = 0.0;
+        double subStepCost = 0.0;
+
+        bool sleeping;
+        Real sleepEnergy;
+        unsigned sleepSteps;
+
         // see implementation for details
-        double stableDragUnderdampedLangevinWithGravityUnitMass(
-            double dt,
-            double gravity,
-            double radius
+        Real stableDragUnderdampedLangevinWithGravityUnitMass(
+            Real dt,
+            Real gravity,
+            Real radius
         );
 
     };
@@ -0,0 +1,124 @@
+#ifndef ENTITYSET_H
+#define ENTITYSET_H
+
+#include <Object/id.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Hop::System
+{
+    using Hop::Object::Id;
+
+    /*
+        A system's members as a sparse set: the Ids packed in a dense
+        vector, plus a sparse Id -> dense position lookup, so insert,
+        erase and contains are O(1) and iteration is a linear walk.
+
+        Ids are sequential, so the lookup is indexed by Id directly,
+        in pages allocated as Ids reach them. Erasing moves the last
+        member into the gap, so members are in insertion order until
+        one is erased.
+    */
+    class EntitySet
+    {
+
+    public:
+
+        typedef std::vector<Id>::const_iterator const_iterator;
+
+        // true when i was not already a member
+        bool insert(const Id & i)
+        {
+            if (contains(i))
+            {
+                return false;
+            }
+
+            uint64_t page = i.id / PAGE_SIZE;
+
+            if (page >= sparse.size())
+            {
+                sparse.resize(page+1);
+            }
+
+            if (sparse[page].empty())
+            {
+                sparse[page].assign(PAGE_SIZE, ABSENT);
+            }
+
+            sparse[page][i.id % PAGE_SIZE] = dense.size();
+            dense.push_back(i);
+
+            return true;
+        }
+
+        // true when i was a member
+        bool erase(const Id & i)
+        {
+            if (!contains(i))
+            {
+                return false;
+            }
+
+            uint64_t & k = position(i);
+            const Id last = dense.back();
+
+            dense[k] = last;
+            position(last) = k;
+            k = ABSENT;
+
+            dense.pop_back();
+
+            return true;
+        }
+
+        bool contains(const Id & i) const
+        {
+            uint64_t page = i.id / PAGE_SIZE;
+
+            return page < sparse.size()
+                && !sparse[page].empty()
+                && sparse[page][i.id % PAGE_SIZE] != ABSENT;
+        }
+
+        void clear()
+        {
+            for (const Id & i : dense)
+            {
+                position(i) = ABSENT;
+            }
+            dense.clear();
+        }
+
+        size_t size() const { return dense.size(); }
+        bool empty() const { return dense.empty(); }
+
+        const Id & operator[](size_t k) const { return dense[k]; }
+
+        const_iterator begin() const { return dense.cbegin(); }
+        const_iterator end() const { return dense.cend(); }
+
+        // the same members, in the same order
+        bool operator==(const EntitySet & s) const { return dense == s.dense; }
+        bool operator!=(const EntitySet & s) const { return !(*this == s); }
+
+    private:
+
+        static constexpr uint64_t PAGE_SIZE = 4096;
+        static constexpr uint64_t ABSENT = std::numeric_limits<uint64_t>::max();
+
+        std::vector<Id> dense;
+        std::vector<std::vector<uint64_t>> sparse;
+
+        uint64_t & position(const Id & i)
+        {
+            return sparse[i.id / PAGE_SIZE][i.id % PAGE_SIZE];
+        }
+
+    };
+
+}
+
+#endif /* ENTITYSET_H */
@@ -1,9 +1,7 @@
 #ifndef SYSTEM_H
 #define SYSTEM_H
 
-#include <Object/id.h>
-
-#include <set>
+#include <System/entitySet.h>
 
 namespace Hop::System
 {
@@ -14,7 +12,7 @@ namespace Hop::System
 
     public:
 
-        std::set<Id> objects;
+        EntitySet objects;
         
     };
 
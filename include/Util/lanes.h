@@ -0,0 +1,217 @@
+#ifndef LANES_H
+#define LANES_H
+
+#include <Util/real.h>
+
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Hop
+{
+    /*
+        Kernels over columns of Real are written once, as a template
+        over a lane type, and instantiated with Lanes, as many Reals
+        as one instruction takes (AVX 4 doubles or 8 floats, SSE2 2
+        or 4), then Lane, a single Real, for the tail.
+
+            for (; k+Lanes::width <= n; k += Lanes::width) { f<Lanes>(k); }
+            for (; k < n; k++) { f<Lane>(k); }
+
+        Each operation is the one instruction (or scalar operation)
+        so a kernel's lanes and tail give identical results. Masks
+        from comparisons choose with select, min is minpd's, the
+        first if less than the second, else the second.
+    */
+
+    struct Lane
+    {
+        static constexpr unsigned width = 1;
+
+        typedef bool Mask;
+
+        Real v;
+
+        Lane() = default;
+        Lane(Real v) : v(v) {}
+
+        static Lane load(const Real * p) { return *p; }
+        static Lane set(Real x) { return x; }
+        void store(Real * p) const { *p = v; }
+
+        friend Lane operator+(Lane a, Lane b) { return a.v+b.v; }
+        friend Lane operator-(Lane a, Lane b) { return a.v-b.v; }
+        friend Lane operator*(Lane a, Lane b) { return a.v*b.v; }
+        friend Lane operator/(Lane a, Lane b) { return a.v/b.v; }
+        friend Lane operator-(Lane a) { return -a.v; }
+
+        friend Mask operator<(Lane a, Lane b) { return a.v < b.v; }
+        friend Mask operator>(Lane a, Lane b) { return a.v > b.v; }
+
+        friend Lane min(Lane a, Lane b) { return a.v < b.v ? a.v : b.v; }
+        friend Lane abs(Lane a) { return std::abs(a.v); }
+        friend Lane select(Mask m, Lane a, Lane b) { return m ? a : b; }
+
+        // bit l set where lane l is
+        static int bits(Mask m) { return m; }
+    };
+
+#if defined(HOP_SINGLE_PRECISION) && defined(__AVX__)
+
+    struct Lanes
+    {
+        static constexpr unsigned width = 8;
+
+        typedef Lanes Mask;
+
+        __m256 v;
+
+        Lanes() = default;
+        Lanes(__m256 v) : v(v) {}
+
+        static Lanes load(const Real * p) { return _mm256_loadu_ps(p); }
+        static Lanes set(Real x) { return _mm256_set1_ps(x); }
+        void store(Real * p) const { _mm256_storeu_ps(p, v); }
+
+        friend Lanes operator+(Lanes a, Lanes b) { return _mm256_add_ps(a.v, b.v); }
+        friend Lanes operator-(Lanes a, Lanes b) { return _mm256_sub_ps(a.v, b.v); }
+        friend Lanes operator*(Lanes a, Lanes b) { return _mm256_mul_ps(a.v, b.v); }
+        friend Lanes operator/(Lanes a, Lanes b) { return _mm256_div_ps(a.v, b.v); }
+        friend Lanes operator-(Lanes a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0)); }
+
+        friend Mask operator<(Lanes a, Lanes b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+        friend Mask operator>(Lanes a, Lanes b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+        friend Mask operator&(Lanes a, Lanes b) { return _mm256_and_ps(a.v, b.v); }
+
+        friend Lanes min(Lanes a, Lanes b) { return _mm256_min_ps(a.v, b.v); }
+        friend Lanes abs(Lanes a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0), a.v); }
+        friend Lanes select(Mask m, Lanes a, Lanes b) { return _mm256_blendv_ps(b.v, a.v, m.v); }
+
+        static int bits(Mask m) { return _mm256_movemask_ps(m.v); }
+    };
+
+#elif defined(HOP_SINGLE_PRECISION) && defined(__SSE2__)
+
+    struct Lanes
+    {
+        static constexpr unsigned width = 4;
+
+        typedef Lanes Mask;
+
+        __m128 v;
+
+        Lanes() = default;
+        Lanes(__m128 v) : v(v) {}
+
+        static Lanes load(const Real * p) { return _mm_loadu_ps(p); }
+        static Lanes set(Real x) { return _mm_set1_ps(x); }
+        void store(Real * p) const { _mm_storeu_ps(p, v); }
+
+        friend Lanes operator+(Lanes a, Lanes b) { return _mm_add_ps(a.v, b.v); }
+        friend Lanes operator-(Lanes a, Lanes b) { return _mm_sub_ps(a.v, b.v); }
+        friend Lanes operator*(Lanes a, Lanes b) { return _mm_mul_ps(a.v, b.v); }
+        friend Lanes operator/(Lanes a, Lanes b) { return _mm_div_ps(a.v, b.v); }
+        friend Lanes operator-(Lanes a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0)); }
+
+        friend Mask operator<(Lanes a, Lanes b) { return _mm_cmplt_ps(a.v, b.v); }
+        friend Mask operator>(Lanes a, Lanes b) { return _mm_cmpgt_ps(a.v, b.v); }
+        friend Mask operator&(Lanes a, Lanes b) { return _mm_and_ps(a.v, b.v); }
+
+        friend Lanes min(Lanes a, Lanes b) { return _mm_min_ps(a.v, b.v); }
+        friend Lanes abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0), a.v); }
+
+        // no blendv before SSE4.1
+        friend Lanes select(Mask m, Lanes a, Lanes b)
+        {
+            return _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v));
+        }
+
+        static int bits(Mask m) { return _mm_movemask_ps(m.v); }
+    };
+
+#elif defined(__AVX__)
+
+    struct Lanes
+    {
+        static constexpr unsigned width = 4;
+
+        typedef Lanes Mask;
+
+        __m256d v;
+
+        Lanes() = default;
+        Lanes(__m256d v) : v(v) {}
+
+        static Lanes load(const Real * p) { return _mm256_loadu_pd(p); }
+        static Lanes set(Real x) { return _mm256_set1_pd(x); }
+        void store(Real * p) const { _mm256_storeu_pd(p, v); }
+
+        friend Lanes operator+(Lanes a, Lanes b) { return _mm256_add_pd(a.v, b.v); }
+        friend Lanes operator-(Lanes a, Lanes b) { return _mm256_sub_pd(a.v, b.v); }
+        friend Lanes operator*(Lanes a, Lanes b) { return _mm256_mul_pd(a.v, b.v); }
+        friend Lanes operator/(Lanes a, Lanes b) { return _mm256_div_pd(a.v, b.v); }
+        friend Lanes operator-(Lanes a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)); }
+
+        friend Mask operator<(Lanes a, Lanes b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+        friend Mask operator>(Lanes a, Lanes b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+        friend Mask operator&(Lanes a, Lanes b) { return _mm256_and_pd(a.v, b.v); }
+
+        friend Lanes min(Lanes a, Lanes b) { return _mm256_min_pd(a.v, b.v); }
+        friend Lanes abs(Lanes a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+        friend Lanes select(Mask m, Lanes a, Lanes b) { return _mm256_blendv_pd(b.v, a.v, m.v); }
+
+        static int bits(Mask m) { return _mm256_movemask_pd(m.v); }
+    };
+
+#elif defined(__SSE2__)
+
+    struct Lanes
+    {
+        static constexpr unsigned width = 2;
+
+        typedef Lanes Mask;
+
+        __m128d v;
+
+        Lanes() = default;
+        Lanes(__m128d v) : v(v) {}
+
+        static Lanes load(const Real * p) { return _mm_loadu_pd(p); }
+        static Lanes set(Real x) { return _mm_set1_pd(x); }
+        void store(Real * p) const { _mm_storeu_pd(p, v); }
+
+        friend Lanes operator+(Lanes a, Lanes b) { return _mm_add_pd(a.v, b.v); }
+        friend Lanes operator-(Lanes a, Lanes b) { return _mm_sub_pd(a.v, b.v); }
+        friend Lanes operator*(Lanes a, Lanes b) { return _mm_mul_pd(a.v, b.v); }
+        friend Lanes operator/(Lanes a, Lanes b) { return _mm_div_pd(a.v, b.v); }
+        friend Lanes operator-(Lanes a) { return _mm_xor_pd(a.v, _mm_set1_pd(-0.0)); }
+
+        friend Mask operator<(Lanes a, Lanes b) { return _mm_cmplt_pd(a.v, b.v); }
+        friend Mask operator>(Lanes a, Lanes b) { return _mm_cmpgt_pd(a.v, b.v); }
+        friend Mask operator&(Lanes a, Lanes b) { return _mm_and_pd(a.v, b.v); }
+
+        friend Lanes min(Lanes a, Lanes b) { return _mm_min_pd(a.v, b.v); }
+        friend Lanes abs(Lanes a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a.v); }
+
+        // no blendv before SSE4.1
+        friend Lanes select(Mask m, Lanes a, Lanes b)
+        {
+            return _mm_or_pd(_mm_and_pd(m.v, a.v), _mm_andnot_pd(m.v, b.v));
+        }
+
+        static int bits(Mask m) { return _mm_movemask_pd(m.v); }
+    };
+
+#else
+
+    typedef Lane Lanes;
+
+#endif
+
+}
+
+#endif /* LANES_H */
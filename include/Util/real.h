@@ -0,0 +1,19 @@
+#ifndef REAL_H
+#define REAL_H
+
+namespace Hop
+{
+    /*
+        The simulation scalar of physics state, primitives and
+        collision forces. Builds with HOP_SINGLE_PRECISION (cmake 
+        -D SINGLE_PRECISION=ON) simulate in float, which Hop's 
+        users must also define. The world stays double.
+    */
+#ifdef HOP_SINGLE_PRECISION
+    typedef float Real;
+#else
+    typedef double Real;
+#endif
+}
+
+#endif /* REAL_H */
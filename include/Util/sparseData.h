@@ -22,9 +22,11 @@ public:
     
     SparseData() {}
 
-    VALUE operator[](INDEX index)
+    // a read, absent indices are VALUE() and are not inserted
+    VALUE operator[](INDEX index) const
     {
-        return elements[index];
+        auto it = elements.find(index);
+        return it == elements.end() ? VALUE() : it->second;
     }
 
     bool notNull(INDEX index)
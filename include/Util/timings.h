@@ -0,0 +1,55 @@
+#ifndef TIMINGS_H
+#define TIMINGS_H
+
+#include <chrono>
+
+namespace Hop::Util
+{
+
+    // seconds spent in each phase of the physics steps timed so far
+    struct PhysicsTimings
+    {
+        double integration = 0.0;
+        double broadPhase = 0.0;
+        double narrowPhase = 0.0;
+        double world = 0.0;
+    };
+
+    /*
+        Wall clock for a phase of a step. It only reads the clock
+        in BENCHMARK builds, otherwise start and stop do nothing
+        and the timings stay zero.
+    */
+    class PhaseClock
+    {
+    public:
+
+        void start()
+        {
+#ifdef BENCHMARK
+            t0 = std::chrono::high_resolution_clock::now();
+#endif
+        }
+
+        // add the seconds since start to t
+        void stop(double & t)
+        {
+#ifdef BENCHMARK
+            t += std::chrono::duration_cast<std::chrono::duration<double>>
+            (
+                std::chrono::high_resolution_clock::now()-t0
+            ).count();
+#endif
+        }
+
+    private:
+
+#ifdef BENCHMARK
+        std::chrono::high_resolution_clock::time_point t0;
+#endif
+
+    };
+
+}
+
+#endif /* TIMINGS_H */
@@ -0,0 +1,41 @@
+#ifndef TYPEINDEX_H
+#define TYPEINDEX_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace Hop::Util
+{
+
+    /*
+        Dense indices for types, 0, 1, 2, ... in order of first use,
+        one sequence per Family, e.g.
+
+            TypeIndex<Component>::of<cPhysics>()
+
+        Replaces keying maps on typeid(T).name(), the index is a
+        function local static so after its first call it is a load
+        (and the initialisation guard's check).
+    */
+    template <class Family>
+    class TypeIndex
+    {
+
+    public:
+
+        template <class T>
+        static uint32_t of()
+        {
+            static const uint32_t index = next++;
+            return index;
+        }
+
+    private:
+
+        static inline std::atomic<uint32_t> next = 0;
+
+    };
+
+}
+
+#endif /* TYPEINDEX_H */
@@ -18,6 +18,7 @@ namespace Hop::World
         virtual ~MapSource() = default;
 
         virtual uint64_t getAtCoordinate(int i, int j) = 0;
+        virtual void setAtCoordinate(int i, int j, uint64_t id) { data.insert(ivec2(i,j), id); }
         virtual void save(std::string fileNameWithoutExtension, bool compressed = true);
         virtual void load(std::string fileNameWithoutExtension, bool compressed = true);
 
@@ -22,6 +22,17 @@ namespace Hop::World
             Boundary<double> * b
         );
 
+        // headless, see AbstractWorld::attachRenderer
+        MarchingWorld(
+            uint64_t s, 
+            uint64_t renderRegion, 
+            uint64_t dynamicsShell,
+            MapSource * f,
+            Boundary<double> * b
+        )
+        : MarchingWorld(s, nullptr, renderRegion, dynamicsShell, f, b)
+        {}
+
         void save(std::string filename){}
         void load(std::string filename){}
 
@@ -3,9 +3,26 @@
 
 #include <World/world.h>
 
+#include <vector>
+
 namespace Hop::World 
 {
 
+    enum class TileSide : uint8_t {WEST, NORTH, EAST, SOUTH};
+
+    /*
+        A blocked edge of a tile, from its neighbour's type.
+        plane is the edge's x (west, east) or y (north, south)
+        for the proximity test, x0..y1 the segment as in 
+        TileBoundsData.
+    */
+    struct TileSegment
+    {
+        TileSide side;
+        double plane;
+        float x0, y0, x1, y1;
+    };
+
     class TileWorld : public AbstractWorld 
     {
         
@@ -20,7 +37,36 @@ namespace Hop::World
             Boundary<double> * b
         );
 
+        // headless, see AbstractWorld::attachRenderer
+        TileWorld(
+            uint64_t s, 
+            uint64_t renderRegion, 
+            uint64_t dynamicsShell,
+            MapSource * f,
+            Boundary<double> * b
+        )
+        : TileWorld(s, nullptr, renderRegion, dynamicsShell, f, b)
+        {}
+
         bool updateRegion(float x, float y);
+
+        void load(std::string fileNameWithoutExtension, bool compressed = true);
+
+        // edit a tile, refreshing the cached segments around it
+        void setTile(int i, int j, uint64_t id);
+
+        /*
+            The blocked edges of tile (i,j) west, north, east, 
+            south. Cached for the loaded region, otherwise built 
+            into scratch (room for 4).
+        */
+        const TileSegment * tileSegments
+        (
+            int i, 
+            int j, 
+            uint8_t & count, 
+            TileSegment * scratch
+        );
         
         void worldToTileData(double x, double y, Tile & h, double & x0, double & y0, double & s, int & i, int & j);
         void boundsTileData(double x, double y, Tile & h, TileBoundsData & bounds, double & x0, double & y0, double & s);
@@ -97,6 +143,32 @@ namespace Hop::World
 
         bool hardOutOfBounds = false;
 
+        /*
+            Tile types of the loaded region plus a ring of one, 
+            and up to 4 segments per region tile, so collisions 
+            in the region make no map lookups.
+        */
+        std::vector<Tile> regionTiles;
+        std::vector<TileSegment> regionSegments;
+        std::vector<uint8_t> regionSegmentCount;
+
+        bool inRegion(int i, int j) const 
+        { 
+            return i >= 0 && j >= 0 && i < int(RENDER_REGION_SIZE) && j < int(RENDER_REGION_SIZE);
+        }
+
+        bool inRegionRing(int i, int j) const 
+        { 
+            return i >= -1 && j >= -1 && i <= int(RENDER_REGION_SIZE) && j <= int(RENDER_REGION_SIZE);
+        }
+
+        size_t regionRingIndex(int i, int j) const { return (i+1)*(RENDER_REGION_SIZE+2)+j+1; }
+        size_t regionIndex(int i, int j) const { return i*RENDER_REGION_SIZE+j; }
+
+        uint8_t buildSegments(int i, int j, TileSegment * segments);
+
+        void cacheRegion();
+
     };
 
 }
@@ -1,21 +1,15 @@
 #ifndef WORLD_H
 #define WORLD_H
 
-#include <jGL/OpenGL/gl.h>
 #include <random>
 #include <string>
 #include <fstream>
 #include <memory>
 
-#include <jGL/OpenGL/Shader/glShader.h>
-
-#include <Shader/marchingQuad.shader>
 #include <World/tile.h>
 
 #include <exception>
 
-#include <jGL/orthoCam.h>
-
 #include <World/boundary.h>
 #include <World/mapSource.h>
 #include <World/fixedSource.h>
@@ -24,6 +18,11 @@
 
 #include <Console/lua.h>
 
+namespace jGL
+{
+    class OrthoCam;
+}
+
 namespace Hop::System::Physics
 {
     class CollisionDetector;
@@ -109,10 +108,12 @@ namespace Hop::World
     using Hop::Util::tupled;
 
     using Hop::System::Physics::CollisionDetector;
-    
-    using jGL::Shader;
+
     using jGL::OrthoCam;
 
+    // the GPU side, only world.cpp and worldRenderer.cpp need OpenGL
+    class WorldRenderer;
+    
     class MapReadException: public std::exception 
     {
 
@@ -150,6 +151,12 @@ namespace Hop::World
         std::string msg;
     };
 
+    /*
+        Streams a region of tiles from a map source around the
+        camera for collisions. With a null camera the world is
+        headless, no OpenGL calls are made, until a renderer is
+        attached.
+    */
     class AbstractWorld 
     {
 
@@ -166,6 +173,11 @@ namespace Hop::World
 
         virtual void draw();
 
+        // create the GPU buffers (needs a GL context) and follow c
+        void attachRenderer(OrthoCam * c);
+
+        bool isHeadless() const { return renderer == nullptr; }
+
         virtual void save(std::string fileNameWithoutExtension, bool compressed = true){map->save(fileNameWithoutExtension, compressed); forceUpdate = true;}
         virtual void load(std::string fileNameWithoutExtension, bool compressed = true){map->load(fileNameWithoutExtension, compressed); forceUpdate = true;}
 
@@ -218,13 +230,7 @@ namespace Hop::World
             return tupled(-double(dynamicsShell),double(dynamicsShell));
         }
 
-        virtual ~AbstractWorld()
-        {
-            glDeleteBuffers(1,&VBOquad);
-            glDeleteBuffers(1,&VBOoffset);
-            glDeleteBuffers(1,&VBOid);
-            glDeleteVertexArrays(1,&VAO);
-        }
+        virtual ~AbstractWorld();
 
         void setGridWidth(double d){ gridWidth = d; }
 
@@ -248,10 +254,6 @@ namespace Hop::World
 
         const uint64_t dynamicsShell;
 
-        glm::mat4 modelView, projection, invProjection, vp;
-
-        void updateProjection();
-
         std::unique_ptr<float[]> dynamicsOffsets;
         std::unique_ptr<float[]> dynamicsIds;
 
@@ -267,23 +269,19 @@ namespace Hop::World
 
         bool forceUpdate;
 
-        GLuint VBOquad, VBOoffset, VBOid, VAO;
-
         Boundary<double> * boundary;
 
         MapSource * map;
 
-        std::unique_ptr<Shader> mapShader;
-
-        float quad[6*4] = {
-        // positions  / texture coords
-        1.0f,  1.0f, 1.0f, 1.0f,   // top right
-        1.0f,  0.0f, 1.0f, 0.0f,   // bottom right
-        0.0f,  0.0f, 0.0f, 0.0f,   // bottom left
-        0.0f,  1.0f, 0.0f, 1.0f,    // top left 
-        0.0f,  0.0f, 0.0f, 0.0f,   // bottom left
-        1.0f,  1.0f, 1.0f, 1.0f  // top right
-        };
+        std::unique_ptr<WorldRenderer> renderer;
+
+        // send the render region to the renderer, if attached
+        void uploadRenderOffsets();
+        void uploadRenderIds();
+
+        // keep the camera, if any, on the region
+        void followRegion();
+
         std::default_random_engine generator;
     };
 
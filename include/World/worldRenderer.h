@@ -0,0 +1,68 @@
+#ifndef WORLDRENDERER_H
+#define WORLDRENDERER_H
+
+#include <jGL/OpenGL/gl.h>
+#include <memory>
+
+#include <jGL/OpenGL/Shader/glShader.h>
+#include <jGL/orthoCam.h>
+
+#include <Shader/marchingQuad.shader>
+
+namespace Hop::World
+{
+
+    using jGL::Shader;
+    using jGL::OrthoCam;
+
+    /*
+        The GPU side of a world, an instanced quad per tile of the
+        render region. Worlds upload their offsets and ids to it
+        when the region changes, and a world without one never
+        touches OpenGL.
+    */
+    class WorldRenderer
+    {
+
+    public:
+
+        WorldRenderer(OrthoCam * c, uint64_t renderRegion);
+
+        ~WorldRenderer();
+
+        // 3 floats (x, y, width) per tile
+        void uploadOffsets(const float * offsets);
+
+        // 1 float (tile id) per tile
+        void uploadIds(const float * ids);
+
+        void draw(float gridWidth);
+
+    private:
+
+        OrthoCam * camera;
+
+        const uint64_t RENDER_REGION_SIZE;
+
+        glm::mat4 modelView, projection, invProjection, vp;
+
+        void updateProjection();
+
+        GLuint VBOquad, VBOoffset, VBOid, VAO;
+
+        std::unique_ptr<Shader> mapShader;
+
+        float quad[6*4] = {
+        // positions  / texture coords
+        1.0f,  1.0f, 1.0f, 1.0f,   // top right
+        1.0f,  0.0f, 1.0f, 0.0f,   // bottom right
+        0.0f,  0.0f, 0.0f, 0.0f,   // bottom left
+        0.0f,  1.0f, 0.0f, 1.0f,    // top left
+        0.0f,  0.0f, 0.0f, 0.0f,   // bottom left
+        1.0f,  1.0f, 1.0f, 1.0f  // top right
+        };
+    };
+
+}
+
+#endif /* WORLDRENDERER_H */
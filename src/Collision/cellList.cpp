@@ -1,5 +1,6 @@
 #include <Collision/cellList.h>
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 using namespace std::chrono;
 
@@ -28,27 +29,7 @@ namespace Hop::System::Physics
         dx = lX / double(rootNCells);
         dy = lY / double(rootNCells);
 
-        cells = std::make_unique<uint64_t[]>(nCells*MAX_PARTICLES_PER_CELL);
-        lastElementInCell = std::make_unique<uint64_t[]>(nCells);
-        id = std::make_unique<std::pair<Id,uint64_t>[]>(MAX_PARTICLES);
-        notEmpty = std::make_unique<bool[]>(nCells);
-
-        lastElement = NULL_INDEX;
-        for (unsigned i = 0; i < nCells; i++)
-        {
-            notEmpty[i] = false;
-            for (unsigned j = 0; j < MAX_PARTICLES_PER_CELL; j++)
-            {
-                cells[i*MAX_PARTICLES_PER_CELL+j] = NULL_INDEX;
-            }
-            
-            lastElementInCell[i] = NULL_INDEX;
-        }
-        for (unsigned i = 0; i < MAX_PARTICLES; i++)
-        {
-            id[i] = std::pair(NULL_ID,NULL_INDEX);
-        }
-
+        allocate();
     }
 
     CellList::CellList(
@@ -64,307 +45,284 @@ namespace Hop::System::Physics
         dx = lX / double(rootNCells);
         dy = lY / double(rootNCells);
 
-        cells = std::make_unique<uint64_t[]>(nCells*MAX_PARTICLES_PER_CELL);
-        lastElementInCell = std::make_unique<uint64_t[]>(nCells);
-        id = std::make_unique<std::pair<Id,uint64_t>[]>(MAX_PARTICLES);
-        notEmpty = std::make_unique<bool[]>(nCells);
-
-        lastElement = NULL_INDEX;
-        for (unsigned i = 0; i < nCells; i++)
-        {
-            notEmpty[i] = false;
-            for (unsigned j = 0; j < MAX_PARTICLES_PER_CELL; j++)
-            {
-                cells[i*MAX_PARTICLES_PER_CELL+j] = NULL_INDEX;
-            }
-            
-            lastElementInCell[i] = NULL_INDEX;
-        }
-        for (unsigned i = 0; i < MAX_PARTICLES; i++)
-        {
-            id[i] = std::pair(NULL_ID,NULL_INDEX);
-        }
+        allocate();
     }
 
-    void CellList::clear(bool full)
+    void CellList::allocate()
     {
-        for (unsigned l = 0; l < nCells; l++)
-        {
-            uint64_t last;
-            notEmpty[l] = false;
-            
-            if (full){last = MAX_PARTICLES_PER_CELL;}
-            
-            if (!full){if (lastElementInCell[l]!= NULL_INDEX){last = lastElementInCell[l]+1;}else{last=0;}}
-            
-            if (last == NULL_INDEX){last = 0;}
-
-            if (last >= 0)
-            {
-                for (unsigned i = 0; i < last; i++)
-                {
-                    cells[l*MAX_PARTICLES_PER_CELL+i] = NULL_INDEX;
-                }
-            }
-
-            lastElementInCell[l] = NULL_INDEX;
-        }
-
-        uint64_t last;
+        cellStart.assign(nCells+1, 0);
+        cellFill.assign(nCells, 0);
+    }
 
-        if (full){last = MAX_PARTICLES;}
+    void CellList::setRootNCells(uint64_t n)
+    {
+        rootNCells = n;
+        nCells = n*n;
 
-        if (!full){if (lastElement != NULL_INDEX){last = lastElement+1;}else{last=0;}}
-        
-        if (last == NULL_INDEX){last = 0;}
-        
-        if (last >= 0)
-        {
-            for (unsigned i = 0; i < last; i++)
-            {
-                id[i] = std::pair(NULL_ID,NULL_INDEX);
-            }
-        }
+        dx = lX / double(rootNCells);
+        dy = lY / double(rootNCells);
 
-        lastElement = NULL_INDEX;
+        allocate();
     }
 
     void CellList::populate(
         ComponentArray<cCollideable> & dataC,
         ComponentArray<cPhysics> & dataP,
-        std::set<Id> objects
+        CollideableView & objects
     )
     {
-        clear();
+        id.clear();
+        cell.clear();
+        object.clear();
+        objectIds.clear();
+        objectIndexC.clear();
+        objectIndexP.clear();
+
+        boundsX.clear();
+        boundsY.clear();
+        boundsR.clear();
+        candidate.clear();
+
+        std::fill(cellStart.begin(), cellStart.end(), 0);
 
-        int o = 0;
-        for (auto it = objects.begin(); it != objects.cend(); it++)
+        const std::vector<Id> & ids = objects.getIds();
+        const std::vector<uint64_t> & indexC = objects.indices<cCollideable>();
+        const std::vector<uint64_t> & indexP = objects.indices<cPhysics>();
+
+        for (uint64_t r = 0; r < ids.size(); r++)
         {
 
-            cPhysics & pData = dataP.get(*it);
+            uint64_t p = indexP[r];
+
+            if (dataP.atIndex(p).isGhost)
+            {
+                continue;
+            }
+
+            uint64_t c = indexC[r];
+
+            CollisionMesh & mesh = dataC.atIndex(c).mesh;
+
+            objectIds.push_back(ids[r]);
+            objectIndexC.push_back(c);
+            objectIndexP.push_back(p);
+            boundsX.push_back(mesh.getBoundsX());
+            boundsY.push_back(mesh.getBoundsY());
+            boundsR.push_back(mesh.getRadius());
+            candidate.push_back(!mesh.getIsRigid());
+        }
+
+        objectBroadPhase();
+
+        // count, offset by one for the prefix sum
 
-            if (pData.isGhost)
+        for (uint64_t o = 0; o < objectIds.size(); o++)
+        {
+            if (!candidate[o])
             {
                 continue;
             }
 
-            cCollideable & data = dataC.get(*it);
+            cCollideable & data = dataC.atIndex(objectIndexC[o]);
 
             uint64_t meshSize = data.mesh.size();
 
             for (unsigned i = 0; i < meshSize; i++)
             {
             
-                std::shared_ptr<CollisionPrimitive> p = data.mesh[i];
+                const CollisionPrimitive & p = data.mesh[i];
 
-                uint64_t h = hash(p->x,p->y);
+                uint64_t h = hash(p.x,p.y);
 
                 if (0 <= h && h < nCells)
                 {
-                    if (lastElementInCell[h] == NULL_INDEX || lastElementInCell[h] < MAX_PARTICLES_PER_CELL)
-                    {
-                        uint64_t next, nextId;
-
-                        if (lastElementInCell[h]==NULL_INDEX){next = 0;}
-                        else {next = lastElementInCell[h]+1;}
-
-                        if (lastElement == NULL_INDEX){nextId = 0;}
-                        else {nextId = lastElement+1;} 
-
-                        cells[h*MAX_PARTICLES_PER_CELL+next]=nextId;
-                        id[nextId] = std::pair(*it,i);
-
-                        lastElement = nextId;
-                        lastElementInCell[h] = next;
-                        notEmpty[h] = true;
-                    }
+                    id.push_back(std::pair(objectIds[o],i));
+                    cell.push_back(h);
+                    object.push_back(o);
+                    cellStart[h+1]++;
                 }
             }
-
-            o++;
-        }
-    }
-
-    void CellList::cellCollisions(
-        uint64_t a1,
-        uint64_t b1,
-        uint64_t a2,
-        uint64_t b2,
-        ComponentArray<cCollideable> & dataC,
-        ComponentArray<cPhysics> & dataP,
-        CollisionResolver * resolver
-    )
-    {
-        if (a1 < 0 || a1 >= rootNCells || b1 < 0 || b2 >= rootNCells || a2 < 0 || a2 >= rootNCells || b2 < 0 || b2 >= rootNCells){
-            return;
         }
 
-        if (!notEmpty[a1*rootNCells+b1] || !notEmpty[a2*rootNCells+b2])
+        for (uint64_t c = 0; c < nCells; c++)
         {
-            return;
+            cellStart[c+1] += cellStart[c];
+            cellFill[c] = cellStart[c];
         }
 
-        uint64_t c1 = (a1*rootNCells+b1)*MAX_PARTICLES_PER_CELL;
-        uint64_t c2 = (a2*rootNCells+b2)*MAX_PARTICLES_PER_CELL;
-
-        uint64_t p1 = 0;
-        uint64_t p2 = 0;
-        uint64_t i, j;
+        // scatter, stable so each cell keeps insertion order
 
-        uint64_t n1 = 0;
-        uint64_t n2 = 0;
+        cellIndex.resize(id.size());
 
-        while(cells[c1+p1] != NULL_INDEX)
+        for (uint64_t k = 0; k < id.size(); k++)
         {
-            n1++;
-            p1++;
+            cellIndex[cellFill[cell[k]]++] = k;
         }
-        while(cells[c2+p2] != NULL_INDEX)
+    }
+
+    void CellList::objectBroadPhase()
+    {
+        objectPairs.clear();
+
+        sweep.resize(objectIds.size());
+
+        for (uint64_t o = 0; o < sweep.size(); o++)
         {
-            n2++;
-            p2++;
+            sweep[o] = o;
         }
 
-        p1 = 0; p2 = 0;
+        std::sort
+        (
+            sweep.begin(),
+            sweep.end(),
+            [this](uint64_t i, uint64_t j)
+            {
+                return boundsX[i]-boundsR[i] < boundsX[j]-boundsR[j];
+            }
+        );
+
+        // objects later in the sweep start further right, so stop
+        //  at the first that starts beyond this one's reach
 
-        while (p1 < n1)
+        for (uint64_t s = 0; s < sweep.size(); s++)
         {
-            p2 = 0;
-            i = cells[c1+p1]; 
-            auto idi = id[i];
-            cCollideable & collidableI = dataC.get(idi.first);
-            cPhysics & physicsI = dataP.get(idi.first);
-            while (p2 < n2)
+            uint64_t i = sweep[s];
+            double reach = boundsX[i]+boundsR[i]+margin;
+
+            for (uint64_t t = s+1; t < sweep.size(); t++)
             {
-                j = cells[c2+p2];
-                auto idj = id[j];
-                cCollideable & collidableJ = dataC.get(idj.first);
-                cPhysics & physicsJ = dataP.get(idj.first);
-                
-                bool c = resolver->handleObjectObjectCollision(
-                    idi.first,idi.second,
-                    idj.first,idj.second,
-                    collidableI, collidableJ,
-                    physicsI, physicsJ
-                );
+                uint64_t j = sweep[t];
 
-                if (c)
+                if (boundsX[j]-boundsR[j] > reach)
                 {
-                    collided.insert(std::pair(idi.first,CollisionType(idj.first,false)));
-                    collided.insert(std::pair(idj.first,CollisionType(idi.first,false)));
+                    break;
+                }
+
+                if (boundsOverlap(i, j))
+                {
+                    objectPairs.push_back(std::pair(i, j));
+                    candidate[i] = true;
+                    candidate[j] = true;
                 }
-                p2++;
             }
-            p1++;
         }
     }
 
-
-    void CellList::cellCollisionsThreaded(
+    void CellList::cellCollisions(
         uint64_t a1,
         uint64_t b1,
         uint64_t a2,
         uint64_t b2,
-        cCollideable * dataC,
-        dense_hash_map<Id,uint64_t> & idToIndexC,
-        cPhysics * dataP,
-        dense_hash_map<Id,uint64_t> & idToIndexP,
-        CollisionResolver * resolver
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        CollisionResolver * resolver,
+        WorkerAccumulator & accumulator
     )
     {
-        if (a1 < 0 || a1 >= rootNCells || b1 < 0 || b2 >= rootNCells || a2 < 0 || a2 >= rootNCells || b2 < 0 || b2 >= rootNCells){
+        if (a1 >= rootNCells || b1 >= rootNCells || a2 >= rootNCells || b2 >= rootNCells){
             return;
         }
 
-        if (!notEmpty[a1*rootNCells+b1] || !notEmpty[a2*rootNCells+b2])
-        {
-            return;
-        }
-
-        uint64_t c1 = (a1*rootNCells+b1)*MAX_PARTICLES_PER_CELL;
-        uint64_t c2 = (a2*rootNCells+b2)*MAX_PARTICLES_PER_CELL;
-
-        uint64_t p1 = 0;
-        uint64_t p2 = 0;
-        uint64_t i, j;
+        uint64_t c1 = a1*rootNCells+b1;
+        uint64_t c2 = a2*rootNCells+b2;
 
-        uint64_t n1 = 0;
-        uint64_t n2 = 0;
+        uint64_t n1 = cellStart[c1+1];
+        uint64_t n2 = cellStart[c2+1];
 
-        while(cells[c1+p1] != NULL_INDEX)
+        if (cellStart[c1] == n1 || cellStart[c2] == n2)
         {
-            n1++;
-            p1++;
-        }
-        while(cells[c2+p2] != NULL_INDEX)
-        {
-            n2++;
-            p2++;
+            return;
         }
 
-        p1 = 0; p2 = 0;
+        double rx, ry, rc;
 
-        while (p1 < n1)
+        for (uint64_t p1 = cellStart[c1]; p1 < n1; p1++)
         {
-            p2 = 0;
-            i = cells[c1+p1]; 
+            uint64_t i = cellIndex[p1];
             auto idi = id[i];
-            cCollideable & collidableI = dataC[idToIndexC[idi.first]];
-            cPhysics & physicsI = dataP[idToIndexP[idi.first]];
+            cCollideable & collidableI = dataC.atIndex(objectIndexC[object[i]]);
+            cPhysics & physicsI = dataP.atIndex(objectIndexP[object[i]]);
+            const CollisionPrimitive & ci = collidableI.mesh[idi.second];
 
-            while (p2 < n2)
+            for (uint64_t p2 = cellStart[c2]; p2 < n2; p2++)
             {
-                j = cells[c2+p2];
+                uint64_t j = cellIndex[p2];
+
+                if (!boundsOverlap(object[i], object[j]))
+                {
+                    continue;
+                }
+
                 auto idj = id[j];
-                cCollideable & collidableJ = dataC[idToIndexC[idj.first]];
-                cPhysics & physicsJ = dataP[idToIndexP[idj.first]];
+                cCollideable & collidableJ = dataC.atIndex(objectIndexC[object[j]]);
+                const CollisionPrimitive & cj = collidableJ.mesh[idj.second];
+
+                if (idi.first == idj.first && collidableI.mesh.getIsRigid())
+                {
+                    continue;
+                }
+
+                // the resolver applies nothing to separated primitives
+                rx = cj.x-ci.x;
+                ry = cj.y-ci.y;
+                rc = ci.r+cj.r;
+
+                if (rx*rx+ry*ry >= rc*rc)
+                {
+                    continue;
+                }
+
+                cPhysics & physicsJ = dataP.atIndex(objectIndexP[object[j]]);
+
+                if (dormant(physicsI, physicsJ))
+                {
+                    continue;
+                }
 
-                bool c = resolver->handleObjectObjectCollision(
+                bool c = resolver->findContacts(
                     idi.first,idi.second,
                     idj.first,idj.second,
                     collidableI, collidableJ,
-                    physicsI, physicsJ
+                    physicsI, physicsJ,
+                    accumulator.contacts
                 );
 
                 if (c)
                 {
-                    collided.insert(std::pair(idi.first,CollisionType(idj.first,false)));
-                    collided.insert(std::pair(idj.first,CollisionType(idi.first,false)));
+                    accumulator.collided.insert(std::pair(idi.first,CollisionType(idj.first,false)));
+                    accumulator.collided.insert(std::pair(idj.first,CollisionType(idi.first,false)));
                 }
-                p2++;
             }
-            p1++;
         }
     }
 
-    void CellList::handleObjectObjectCollisionsThreaded(
-        cCollideable * dataC,
-        dense_hash_map<Id,uint64_t> & idToIndexC,
-        cPhysics * dataP,
-        dense_hash_map<Id,uint64_t> & idToIndexP,
+    void CellList::handleOccupiedCells(
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
         CollisionResolver * resolver,
-        std::pair<unsigned,unsigned> * jobs,
-        unsigned njobs
+        uint64_t begin,
+        uint64_t end,
+        unsigned worker
     )
     {
-        unsigned a, b, a1, b1;
+        uint64_t a, b;
 
-        for (unsigned j = 0; j < njobs; j++)
+        WorkerAccumulator & accumulator = accumulators[worker];
+
+        for (uint64_t k = begin; k < end; k++)
         {
-            a = jobs[j].first;
-            b = jobs[j].second;
-            a1 = a+1;
-            b1 = b+1;
+            a = occupiedCells[k] / rootNCells;
+            b = occupiedCells[k] % rootNCells;
 
             // takes advantage of symmetry
             //  i.e cell a-1,b-1 will collide with
             //  cell a,b so no need to double up!
             
-            cellCollisionsThreaded(a,b,a,b,dataC,idToIndexC,dataP,idToIndexP,resolver);
-            cellCollisionsThreaded(a,b,a1,b1,dataC,idToIndexC,dataP,idToIndexP,resolver);
-            cellCollisionsThreaded(a,b,a,b1,dataC,idToIndexC,dataP,idToIndexP,resolver);
-            cellCollisionsThreaded(a,b,a1,b,dataC,idToIndexC,dataP,idToIndexP,resolver);
-            cellCollisionsThreaded(a,b,a1,b-1,dataC,idToIndexC,dataP,idToIndexP,resolver);
+            cellCollisions(a,b,a,b,dataC,dataP,resolver,accumulator);
+            cellCollisions(a,b,a+1,b+1,dataC,dataP,resolver,accumulator);
+            cellCollisions(a,b,a,b+1,dataC,dataP,resolver,accumulator);
+            cellCollisions(a,b,a+1,b,dataC,dataP,resolver,accumulator);
+            cellCollisions(a,b,a+1,b-1,dataC,dataP,resolver,accumulator);
         }
     }
 
@@ -372,136 +330,161 @@ namespace Hop::System::Physics
         ComponentArray<cCollideable> & dataC,
         ComponentArray<cPhysics> & dataP,
         CollisionResolver * resolver,
-        std::set<Id> objects,
+        CollideableView & objects,
         ThreadPool * workers
     )
     {
         collided.clear();
-        populate(dataC, dataP ,objects);
-   
-        int a1, b1;
+        contacts.clear();
 
-        if (workers != nullptr){
+        clock.start();
 
-            unsigned nThreads = workers->size();
-
-            unsigned jobsPerThread = std::floor(nCells / nThreads);
-            std::pair<unsigned,unsigned> threadJobs[nThreads][jobsPerThread];
-            std::pair<unsigned,unsigned> jobs[nCells];
-
-            unsigned k = 0;
-            for (unsigned i = 0; i < rootNCells; i++){
-                for (unsigned j = 0; j < rootNCells; j++)
-                {
-                    jobs[k] = std::pair<unsigned,unsigned>(i,j);
-                    k++;
-                }
-            }
+        populate(dataC, dataP ,objects);
 
-            for (unsigned t = 0; t < nThreads; t++)
-            {
-                unsigned k = 0;
-                for (unsigned j = 0; j < jobsPerThread; j++)
-                {
-                    threadJobs[t][k] = jobs[j+jobsPerThread*t];
-                    k++;
-                }
-            }
+        occupiedCells.clear();
 
-            if (dataC.allocatedWorkerData() < nThreads)
+        for (uint64_t c = 0; c < nCells; c++)
+        {
+            if (cellSize(c) > 0)
             {
-                dataC.allocateWorkerData(nThreads);
+                occupiedCells.push_back(c);
             }
+        }
 
-            if (dataP.allocatedWorkerData() < nThreads)
-            {
-                dataP.allocateWorkerData(nThreads);
-            }
+        // without workers one accumulator takes every cell
+        unsigned nThreads = workers == nullptr ? 1 : workers->size();
 
-            for (unsigned t = 0; t < nThreads; t++)
-            {
-                workers->queueJob
-                (
-                    std::bind
-                    (
-                        &ComponentArray<cCollideable>::scatter,
-                        &dataC,
-                        t
-                    )
-                );
+        accumulators.resize(nThreads);
 
-                workers->queueJob
-                (
-                    std::bind
-                    (
-                        &ComponentArray<cPhysics>::scatter,
-                        &dataP,
-                        t
-                    )
-                );
+        for (WorkerAccumulator & w : accumulators)
+        {
+            w.contacts.clear();
+            w.collided.clear();
+        }
 
-            }
+        clock.stop(timings.broadPhase);
+        clock.start();
 
-            workers->wait();
+        uint64_t n = occupiedCells.size();
 
+        if (workers == nullptr)
+        {
+            handleOccupiedCells(dataC, dataP, resolver, 0, n, 0);
+        }
+        else
+        {
             for (unsigned t = 0; t < nThreads; t++)
             {
+                uint64_t begin = (n*t)/nThreads;
+                uint64_t end = (n*(t+1))/nThreads;
+
+                if (begin == end)
+                {
+                    continue;
+                }
+
                 workers->queueJob
                 (
                     std::bind
                     (
-                        &CellList::handleObjectObjectCollisionsThreaded,
+                        &CellList::handleOccupiedCells,
                         this,
-                        dataC.getWorkerData(t),
-                        std::ref(dataC.getIdToIndex()),
-                        dataP.getWorkerData(t),
-                        std::ref(dataP.getIdToIndex()),
+                        std::ref(dataC),
+                        std::ref(dataP),
                         resolver,
-                        &threadJobs[t][0],
-                        jobsPerThread
+                        begin,
+                        end,
+                        t
                     )
                 );
             }
+
             workers->wait();
+        }
+
+        for (WorkerAccumulator & w : accumulators)
+        {
+            contacts.append(w.contacts);
+            collided.append(w.collided);
+        }
+
+        if (workers == nullptr)
+        {
+            resolver->evaluateContacts(contacts, 0, contacts.size());
+        }
+        else
+        {
+            // forces are independent per contact, split them evenly
+
+            n = contacts.size();
 
             for (unsigned t = 0; t < nThreads; t++)
             {
+                uint64_t begin = (n*t)/nThreads;
+                uint64_t end = (n*(t+1))/nThreads;
+
+                if (begin == end)
+                {
+                    continue;
+                }
+
                 workers->queueJob
                 (
                     std::bind
                     (
-                        &ComponentArray<cPhysics>::reduce,
-                        &dataP,
-                        t,
-                        REDUCTION_TYPE::SUM_EQUALS
+                        &CollisionResolver::evaluateContacts,
+                        resolver,
+                        std::ref(contacts),
+                        begin,
+                        end
                     )
                 );
             }
 
             workers->wait();
-            
         }
-        else
+
+        contacts.apply();
+
+        collided.sort();
+
+        clock.stop(timings.narrowPhase);
+    }
+
+    void CellList::handleWorldObjects(
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        CollisionResolver * resolver,
+        AbstractWorld * world,
+        const std::vector<Id> & ids,
+        const std::vector<uint64_t> & indexC,
+        const std::vector<uint64_t> & indexP,
+        uint64_t begin,
+        uint64_t end,
+        unsigned worker
+    )
+    {
+        CollisionLog & workerCollided = accumulators[worker].collided;
+
+        for (uint64_t k = begin; k < end; k++)
         {
-            for (unsigned a = 0; a < rootNCells; a++)
+            const Id & id = ids[k];
+
+            cCollideable & c = dataC.atIndex(indexC[k]);
+            cPhysics & p = dataP.atIndex(indexP[k]);
+
+            if (p.isGhost || p.isAsleep)
             {
-                a1 = a+1;
-                for (unsigned b = 0; b < rootNCells; b++)
-                {
-                    b1 = b+1;
-                    // takes advantage of symmetry
-                    //  i.e cell a-1,b-1 will collide with
-                    //  cell a,b so no need to double up!
-                    
-                    cellCollisions(a,b,a,b,dataC,dataP,resolver);
-                    cellCollisions(a,b,a1,b1,dataC,dataP,resolver);
-                    cellCollisions(a,b,a,b1,dataC,dataP,resolver);
-                    cellCollisions(a,b,a1,b,dataC,dataP,resolver);
-                    cellCollisions(a,b,a1,b-1,dataC,dataP,resolver);
-                }
+                continue;
+            }
+
+            // reads the world, writes only this object
+
+            if (resolver->handleObjectWorldCollision(id, c, p, world))
+            {
+                workerCollided.insert(std::pair(id,CollisionType(NULL_ID,true)));
             }
         }
-        
     }
 
     void CellList::handleObjectWorldCollisions(
@@ -509,31 +492,76 @@ namespace Hop::System::Physics
         ComponentArray<cPhysics> & dataP,
         CollisionResolver * resolver,
         AbstractWorld * world,
-        std::set<Id> objects,
+        CollideableView & objects,
         ThreadPool * workers
     )
     {
-        for (auto it = objects.begin(); it != objects.end(); it++)
+        clock.start();
+
+        resolver->prepareWorld(world);
+
+        unsigned nThreads = workers == nullptr ? 1 : workers->size();
+
+        accumulators.resize(nThreads);
+
+        for (WorkerAccumulator & w : accumulators)
         {
-            cCollideable & c = dataC.get(*it);
-            cPhysics & p = dataP.get(*it);
+            w.collided.clear();
+        }
 
-            if (p.isGhost)
-            {
-                continue;
-            }
+        // refreshed here, so workers only read the columns
+        const std::vector<Id> & ids = objects.getIds();
+        const std::vector<uint64_t> & indexC = objects.indices<cCollideable>();
+        const std::vector<uint64_t> & indexP = objects.indices<cPhysics>();
 
-            bool col = resolver->handleObjectWorldCollision(
-                *it,
-                c,
-                p,
-                world
-            );
+        uint64_t n = ids.size();
 
-            if (col)
+        if (workers == nullptr)
+        {
+            handleWorldObjects(dataC, dataP, resolver, world, ids, indexC, indexP, 0, n, 0);
+        }
+        else
+        {
+            for (unsigned t = 0; t < nThreads; t++)
             {
-                collided.insert(std::pair(*it,CollisionType(NULL_ID,true)));
+                uint64_t begin = (n*t)/nThreads;
+                uint64_t end = (n*(t+1))/nThreads;
+
+                if (begin == end)
+                {
+                    continue;
+                }
+
+                workers->queueJob
+                (
+                    std::bind
+                    (
+                        &CellList::handleWorldObjects,
+                        this,
+                        std::ref(dataC),
+                        std::ref(dataP),
+                        resolver,
+                        world,
+                        std::cref(ids),
+                        std::cref(indexC),
+                        std::cref(indexP),
+                        begin,
+                        end,
+                        t
+                    )
+                );
             }
+
+            workers->wait();
         }
+
+        for (WorkerAccumulator & w : accumulators)
+        {
+            collided.append(w.collided);
+        }
+
+        collided.sort();
+
+        clock.stop(timings.world);
     }
-}
\ No newline at end of file
+}
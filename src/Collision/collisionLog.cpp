@@ -0,0 +1,131 @@
+#include <Collision/collisionLog.h>
+
+#include <algorithm>
+
+namespace Hop::System::Physics
+{
+
+    static bool entryBefore(const CollisionLog::Entry & a, const CollisionLog::Entry & b)
+    {
+        if (a.first.id != b.first.id)
+        {
+            return a.first.id < b.first.id;
+        }
+
+        if (a.second.with.id != b.second.with.id)
+        {
+            return a.second.with.id < b.second.with.id;
+        }
+
+        return a.second.world < b.second.world;
+    }
+
+    static bool entrySame(const CollisionLog::Entry & a, const CollisionLog::Entry & b)
+    {
+        return a.first.id == b.first.id &&
+            a.second.with.id == b.second.with.id &&
+            a.second.world == b.second.world;
+    }
+
+    static uint64_t entryHash(const CollisionLog::Entry & e)
+    {
+        uint64_t h = e.first.id*0x9e3779b97f4a7c15ull;
+        h ^= (e.second.with.id*2+uint64_t(e.second.world))*0xc2b2ae3d27d4eb4full;
+        return h ^ (h >> 29);
+    }
+
+    void CollisionLog::clear()
+    {
+        entries.clear();
+        std::fill(slots.begin(), slots.end(), 0);
+        sorted = true;
+    }
+
+    bool CollisionLog::place(uint32_t k) const
+    {
+        uint64_t mask = slots.size()-1;
+
+        for (uint64_t s = entryHash(entries[k]) & mask;; s = (s+1) & mask)
+        {
+            if (slots[s] == 0)
+            {
+                slots[s] = k+1;
+                return true;
+            }
+
+            if (entrySame(entries[slots[s]-1], entries[k]))
+            {
+                return false;
+            }
+        }
+    }
+
+    void CollisionLog::index() const
+    {
+        std::fill(slots.begin(), slots.end(), 0);
+
+        for (uint32_t k = 0; k < entries.size(); k++)
+        {
+            place(k);
+        }
+    }
+
+    void CollisionLog::insert(const Entry & e)
+    {
+        if (2*(entries.size()+1) > slots.size())
+        {
+            slots.resize(std::max(size_t(64), 2*slots.size()));
+            index();
+        }
+
+        entries.push_back(e);
+
+        if (!place(entries.size()-1))
+        {
+            entries.pop_back();
+            return;
+        }
+
+        sorted = sorted && (entries.size() < 2 || entryBefore(entries[entries.size()-2], e));
+    }
+
+    void CollisionLog::order() const
+    {
+        if (sorted)
+        {
+            return;
+        }
+
+        std::sort(entries.begin(), entries.end(), entryBefore);
+        index();
+        sorted = true;
+    }
+
+    std::pair<CollisionLog::const_iterator, CollisionLog::const_iterator> CollisionLog::equal_range(const Id & id) const
+    {
+        order();
+
+        auto lower = std::partition_point
+        (
+            entries.cbegin(), 
+            entries.cend(), 
+            [&id](const Entry & e) { return e.first.id < id.id; }
+        );
+
+        auto upper = std::partition_point
+        (
+            lower, 
+            entries.cend(), 
+            [&id](const Entry & e) { return e.first.id == id.id; }
+        );
+
+        return std::pair(lower, upper);
+    }
+
+    bool CollisionLog::contains(const Id & id) const
+    {
+        auto range = equal_range(id);
+        return range.first != range.second;
+    }
+
+}
@@ -5,157 +5,265 @@ namespace Hop::System::Physics
 {
     void CollisionMesh::updateWorldMeshRigid(
         const cTransform & transform,
-        double dt
+        Real dt
     )
     {
-        double c = std::cos(transform.theta);
-        double s = std::sin(transform.theta);
+        Real c = std::cos(transform.theta);
+        Real s = std::sin(transform.theta);
 
         std::vector<uint8_t> inside(worldVertices.size());
 
         for (unsigned i = 0; i < vertices.size(); i++)
         {
-            inside[i] = worldVertices[i]->lastInside;
-            worldVertices[i]->setOrigin
+            inside[i] = worldVertices[i].lastInside;
+            worldVertices[i].setOrigin
             (
-                (vertices[i]->x*c + vertices[i]->y*s)*transform.scale + transform.x,
-                (vertices[i]->y*c - vertices[i]->x*s)*transform.scale + transform.y
+                (vertices[i].x*c + vertices[i].y*s)*transform.scale + transform.x,
+                (vertices[i].y*c - vertices[i].x*s)*transform.scale + transform.y
             );
 
-            worldVertices[i]->r = vertices[i]->r*transform.scale;
-            worldVertices[i]->lastInside = inside[i]; 
+            worldVertices[i].r = vertices[i].r*transform.scale;
+            worldVertices[i].lastInside = inside[i]; 
         }
 
         // break of into second loop to allow for vectorisation of the above loop
         // cf updateWorldMeshSoft
         if (someRectangles)
         {
-            for (unsigned i = 0; i < vertices.size(); i++)
+            placeRectangles(c, s, transform.scale*2.0, transform.x, transform.y);
+        }
+
+        computeRadius();
+        needsInit = false;
+    }
+
+    void CollisionMesh::placeRectangles
+    (
+        Real cosine,
+        Real sine,
+        Real scale,
+        Real x,
+        Real y
+    )
+    {
+        /*
+            Corners, centre and axes in world space straight from
+            the model rectangle, once per step. The model axes are
+            unit and rotate with the corners, so unlike
+            RectanglePrimitive::rotateClockWise no square roots are
+            taken. Collision tests then read these cached values.
+        */
+        for (unsigned i = 0; i < vertices.size(); i++)
+        {
+            RectanglePrimitive & lw = worldVertices[i];
+            const MeshRectangle & lv = vertices[i];
+
+            if (!(lw.isRectangle() && lv.isRectangle()))
             {
-                RectanglePrimitive * lw = dynamic_cast<RectanglePrimitive*>(worldVertices[i].get());
-                MeshRectangle * lv = dynamic_cast<MeshRectangle*>(vertices[i].get());
+                continue;
+            }
 
-                if (lw != nullptr && lv != nullptr)
-                {
-                    lw->llx = lv->llx;
-                    lw->lly = lv->lly;
+            lw.llx = (lv.llx*cosine + lv.lly*sine)*scale + x;
+            lw.lly = (lv.lly*cosine - lv.llx*sine)*scale + y;
 
-                    lw->ulx = lv->ulx;
-                    lw->uly = lv->uly;
+            lw.ulx = (lv.ulx*cosine + lv.uly*sine)*scale + x;
+            lw.uly = (lv.uly*cosine - lv.ulx*sine)*scale + y;
 
-                    lw->urx = lv->urx;
-                    lw->ury = lv->ury;
+            lw.urx = (lv.urx*cosine + lv.ury*sine)*scale + x;
+            lw.ury = (lv.ury*cosine - lv.urx*sine)*scale + y;
 
-                    lw->lrx = lv->lrx;
-                    lw->lry = lv->lry;
+            lw.lrx = (lv.lrx*cosine + lv.lry*sine)*scale + x;
+            lw.lry = (lv.lry*cosine - lv.lrx*sine)*scale + y;
 
-                    lw->x = lv->x;
-                    lw->y = lv->y;
-                    lw->r = lv->r;
-                    
-                    lw->rotateClockWise(c, s);
-                    lw->scale(transform.scale*2.0);
-                    lw->translate(transform.x, transform.y);
+            lw.x = (lv.x*cosine + lv.y*sine)*scale + x;
+            lw.y = (lv.y*cosine - lv.x*sine)*scale + y;
+            lw.r = lv.r*scale;
 
-                }
-            }
-        }
+            lw.axis1x = lv.axis1x*cosine + lv.axis1y*sine;
+            lw.axis1y = lv.axis1y*cosine - lv.axis1x*sine;
 
-        computeRadius();
-        needsInit = false;
+            lw.axis2x = lv.axis2x*cosine + lv.axis2y*sine;
+            lw.axis2y = lv.axis2y*cosine - lv.axis2x*sine;
+        }
     }
 
-    void CollisionMesh::centerOfMassWorld(double & cx, double & cy)
+    void CollisionMesh::centerOfMassWorld(Real & cx, Real & cy)
     {
         cx = 0.0;
         cy = 0.0;
         for (unsigned i = 0; i < worldVertices.size(); i++)
         {
-            cx += worldVertices[i]->x;
-            cy += worldVertices[i]->y;
+            cx += worldVertices[i].x;
+            cy += worldVertices[i].y;
         }
-        cx /= double(worldVertices.size());
-        cy /= double(worldVertices.size());
+        cx /= Real(worldVertices.size());
+        cy /= Real(worldVertices.size());
     }
 
     void CollisionMesh::modelToCenterOfMassFrame()
     {
-        double cx = 0.0;
-        double cy = 0.0;
+        Real cx = 0.0;
+        Real cy = 0.0;
         for (unsigned i = 0; i < vertices.size(); i++)
         {
-            cx += vertices[i]->x;
-            cy += vertices[i]->y;
+            cx += vertices[i].x;
+            cy += vertices[i].y;
         }
-        cx /= double(vertices.size());
-        cy /= double(vertices.size());
+        cx /= Real(vertices.size());
+        cy /= Real(vertices.size());
 
         for (unsigned i = 0; i < vertices.size(); i++)
         {
-            vertices[i]->x -= cx;
-            vertices[i]->y -= cy;
+            vertices[i].x -= cx;
+            vertices[i].y -= cy;
         }
     }
 
-    double CollisionMesh::bestAngle(double x, double y, double scale)
+    Real CollisionMesh::bestAngle(Real x, Real y, Real scale)
     {
-        double cx = 0.0;
-        double cy = 0.0;
+        Real cx = 0.0;
+        Real cy = 0.0;
         centerOfMassWorld(cx, cy);
-        double a = 0.0;
-        double b = 0.0;
-        double refx, refy;
-        double rx, ry;
+        Real a = 0.0;
+        Real b = 0.0;
+        Real refx, refy;
+        Real rx, ry;
 
         for (unsigned i = 0; i < worldVertices.size(); i++)
         {
-            refx = vertices[i]->x*scale + x;
-            refy = vertices[i]->y*scale + y;
-            rx = worldVertices[i]->x-cx;
-            ry = worldVertices[i]->y-cy;
+            refx = vertices[i].x*scale + x;
+            refy = vertices[i].y*scale + y;
+            rx = worldVertices[i].x-cx;
+            ry = worldVertices[i].y-cy;
 
             b += rx*refx + ry*refy;
             a += rx*refy - ry*refx;
         }
 
-        double omega = std::atan2(a, b);
+        Real omega = std::atan2(a, b);
 
         return omega;
     }
 
+    void CollisionMesh::subCycleSoft(
+        const cTransform & transform,
+        const cPhysics & physics,
+        Real dt,
+        Real phi,
+        unsigned subCycles
+    )
+    {
+        /*
+            The internal springs are stiff (up to RIGID) so here take
+            subCycles steps of dt/subCycles, holding the collision and
+            torque forces constant over them. The caller's step, with
+            its collision detection, may then be subCycles times longer.
+
+            The Verlet history is one dt's displacement between steps,
+            and stepGlobal's, so is scaled to one sub step while cycling
+            and back after. The relaxed positions carry on at the mesh's
+            velocity and spin through the sub steps, as a single step's
+            would move between steps, rather than holding the mesh back.
+            Both are taken from the history itself, physics.omega would
+            lead the primitives and drive the spin up.
+        */
+        Real h = dt/Real(subCycles);
+        Real hh = h*h;
+        Real toSubStep = 1.0/Real(subCycles);
+
+        Real dx = 0.0;
+        Real dy = 0.0;
+        Real spin = 0.0;
+        Real r2 = 0.0;
+
+        for (CollisionPrimitive & p : worldVertices)
+        {
+            p.applyTorque(physics.tau, transform.x, transform.y);
+
+            p.applyTorque(-physics.omega*physics.rotationalDrag, transform.x, transform.y);
+
+            Real rx = p.x-transform.x;
+            Real ry = p.y-transform.y;
+
+            dx += p.x-p.xp;
+            dy += p.y-p.yp;
+            spin += rx*(p.y-p.yp)-ry*(p.x-p.xp);
+            r2 += rx*rx+ry*ry;
+
+            p.xp = p.x - (p.x-p.xp)*toSubStep;
+            p.yp = p.y - (p.y-p.yp)*toSubStep;
+        }
+
+        dx *= toSubStep/Real(worldVertices.size());
+        dy *= toSubStep/Real(worldVertices.size());
+        spin = r2 > 0.0 ? -spin*toSubStep/r2 : 0.0;
+
+        for (unsigned k = 0; k < subCycles; k++)
+        {
+            Real co = std::cos(phi + spin*k);
+            Real so = std::sin(phi + spin*k);
+            Real x = transform.x + dx*k;
+            Real y = transform.y + dy*k;
+
+            for (unsigned i = 0; i < vertices.size(); i++)
+            {
+                worldVertices[i].step
+                (
+                    h,
+                    hh,
+                    physics.translationalDrag,
+                    (vertices[i].x*co + vertices[i].y*so)*transform.scale + x,
+                    (vertices[i].y*co - vertices[i].x*so)*transform.scale + y,
+                    k+1 == subCycles
+                );
+            }
+        }
+
+        for (unsigned i = 0; i < vertices.size(); i++)
+        {
+            CollisionPrimitive & p = worldVertices[i];
+
+            p.xp = p.x - (p.x-p.xp)*Real(subCycles);
+            p.yp = p.y - (p.y-p.yp)*Real(subCycles);
+
+            p.r = vertices[i].r*transform.scale;
+        }
+    }
+
     void CollisionMesh::updateWorldMeshSoft(
         cTransform & transform,
         cPhysics & physics,
-        double dt
+        Real dt,
+        unsigned subCycles
     )
     {
 
-        double c = std::cos(transform.theta);
-        double s = std::sin(transform.theta);
+        Real c = std::cos(transform.theta);
+        Real s = std::sin(transform.theta);
 
         if (needsInit)
         {
             modelToCenterOfMassFrame();
             for (unsigned i = 0; i < vertices.size(); i++)
             {
-                worldVertices[i]->setOrigin
+                worldVertices[i].setOrigin
                 (
-                    (vertices[i]->x*c + vertices[i]->y*s)*transform.scale + transform.x,
-                    (vertices[i]->y*c - vertices[i]->x*s)*transform.scale + transform.y
+                    (vertices[i].x*c + vertices[i].y*s)*transform.scale + transform.x,
+                    (vertices[i].y*c - vertices[i].x*s)*transform.scale + transform.y
                 );
             }
         }
 
-        double phi = bestAngle(transform.x, transform.y, transform.scale);
+        Real phi = bestAngle(transform.x, transform.y, transform.scale);
 
-        physics.omega = Hop::Maths::angleDistanceAtan2<double>(transform.theta, phi);
+        physics.omega = Hop::Maths::angleDistanceAtan2<Real>(transform.theta, phi);
 
         transform.theta = phi;
 
-        double co = std::cos(phi);
-        double so = std::sin(phi);
+        Real co = std::cos(phi);
+        Real so = std::sin(phi);
 
-        double dtdt = dt*dt;
+        Real dtdt = dt*dt;
 
         physics.vx = -transform.x;
         physics.vy = -transform.y;
@@ -166,86 +274,62 @@ namespace Hop::System::Physics
         {
             for (unsigned i = 0; i < vertices.size(); i++)
             {
-                worldVertices[i]->setOrigin
+                worldVertices[i].setOrigin
                 (
-                    (vertices[i]->x*c + vertices[i]->y*s)*transform.scale + transform.x,
-                    (vertices[i]->y*c - vertices[i]->x*s)*transform.scale + transform.y
+                    (vertices[i].x*c + vertices[i].y*s)*transform.scale + transform.x,
+                    (vertices[i].y*c - vertices[i].x*s)*transform.scale + transform.y
                 );
-                worldVertices[i]->r = vertices[i]->r*transform.scale;
-                worldVertices[i]->lastInside = inside[i]; 
+                worldVertices[i].r = vertices[i].r*transform.scale;
+                worldVertices[i].lastInside = inside[i]; 
             }
         }
 
-        if (!needsInit && physics.isMoveable)
+        if (!needsInit && physics.isMoveable && subCycles > 1)
+        {
+            subCycleSoft(transform, physics, dt, phi, subCycles);
+        }
+        else if (!needsInit && physics.isMoveable)
         {
             // should be vectorisable, split with prior and next loop
             //  to make branchless. Indeed we got down to O(1e-7) from O(1e-6)
             //  on pure circles 
             for (unsigned i = 0; i < vertices.size(); i++)
             {
-                inside[i] = worldVertices[i]->lastInside;
+                inside[i] = worldVertices[i].lastInside;
 
-                worldVertices[i]->applyTorque(physics.tau, transform.x, transform.y);
+                worldVertices[i].applyTorque(physics.tau, transform.x, transform.y);
 
-                worldVertices[i]->applyTorque(-physics.omega*physics.rotationalDrag, transform.x, transform.y);
+                worldVertices[i].applyTorque(-physics.omega*physics.rotationalDrag, transform.x, transform.y);
 
-                worldVertices[i]->step
+                worldVertices[i].step
                 (
                     dt,
                     dtdt,
                     physics.translationalDrag,
-                    (vertices[i]->x*co + vertices[i]->y*so)*transform.scale + transform.x,
-                    (vertices[i]->y*co - vertices[i]->x*so)*transform.scale + transform.y
+                    (vertices[i].x*co + vertices[i].y*so)*transform.scale + transform.x,
+                    (vertices[i].y*co - vertices[i].x*so)*transform.scale + transform.y
                 );
 
-                worldVertices[i]->r = vertices[i]->r*transform.scale;
-                worldVertices[i]->lastInside = inside[i]; 
+                worldVertices[i].r = vertices[i].r*transform.scale;
+                worldVertices[i].lastInside = inside[i]; 
             }
         }
 
         if (someRectangles)
         {
-            for (unsigned i = 0; i < vertices.size(); i++)
-            {
-                RectanglePrimitive * lw = dynamic_cast<RectanglePrimitive*>(worldVertices[i].get());
-                MeshRectangle * lv = dynamic_cast<MeshRectangle*>(vertices[i].get());
-
-                if (lw != nullptr && lv != nullptr)
-                {
-                    lw->llx = lv->llx;
-                    lw->lly = lv->lly;
-
-                    lw->ulx = lv->ulx;
-                    lw->uly = lv->uly;
-
-                    lw->urx = lv->urx;
-                    lw->ury = lv->ury;
-
-                    lw->lrx = lv->lrx;
-                    lw->lry = lv->lry;
-
-                    lw->x = lv->x;
-                    lw->y = lv->y;
-                    lw->r = lv->r;
-                    
-                    lw->rotateClockWise(c, s);
-                    lw->scale(transform.scale*2.0);
-                    lw->translate(transform.x, transform.y);
-
-                }
-            }
+            placeRectangles(c, s, transform.scale*2.0, transform.x, transform.y);
         }
 
         centerOfMassWorld(transform.x, transform.y);
 
         if (physics.isMoveable)
         {
-            double dx = 0.0; 
-            double dy = 0.0;
+            Real dx = 0.0; 
+            Real dy = 0.0;
             
             for (unsigned i = 0; i < vertices.size(); i++)
             {
-                worldVertices[i]->stepGlobal
+                worldVertices[i].stepGlobal
                 (
                     dt, dtdt, physics, gx, gy, dx, dy
                 );
@@ -265,21 +349,21 @@ namespace Hop::System::Physics
             kineticEnergy += (dx*dx+dy*dy)/(dt*dt);
         }
 
-        for (auto p : worldVertices)
+        for (const CollisionPrimitive & p : worldVertices)
         {
-            kineticEnergy += p->vx*p->vx+p->vy*p->vy;
+            kineticEnergy += p.vx*p.vx+p.vy*p.vy;
         }
 
         if (needsInit)
         {
-            double c = std::cos(transform.theta);
-            double s = std::sin(transform.theta);
+            Real c = std::cos(transform.theta);
+            Real s = std::sin(transform.theta);
             for (unsigned i = 0; i < vertices.size(); i++)
             {
-                worldVertices[i]->setOrigin
+                worldVertices[i].setOrigin
                 (
-                    (vertices[i]->x*c + vertices[i]->y*s)*transform.scale + transform.x,
-                    (vertices[i]->y*c - vertices[i]->x*s)*transform.scale + transform.y
+                    (vertices[i].x*c + vertices[i].y*s)*transform.scale + transform.x,
+                    (vertices[i].y*c - vertices[i].x*s)*transform.scale + transform.y
                 );
             }
         }
@@ -290,61 +374,70 @@ namespace Hop::System::Physics
 
     void CollisionMesh::computeRadius()
     {
-        double mx = 0.0;
-        double Mx = 0.0;
-        double my = 0.0;
-        double My = 0.0;
+        Real mx = 0.0;
+        Real Mx = 0.0;
+        Real my = 0.0;
+        Real My = 0.0;
         for (unsigned i = 0; i < vertices.size(); i++)
         {
-            std::shared_ptr<CollisionPrimitive> p = worldVertices[i];
+            const CollisionPrimitive & p = worldVertices[i];
             if (i == 0){
-                mx = p->x-p->r;
-                Mx = p->x+p->r;
-                my = p->y-p->r;
-                My = p->y+p->r;
+                mx = p.x-p.r;
+                Mx = p.x+p.r;
+                my = p.y-p.r;
+                My = p.y+p.r;
             }
             else
             {
-                mx = std::min(p->x-p->r,mx);
-                Mx = std::max(p->x+p->r,Mx);
-                my = std::min(p->y-p->r,my);
-                My = std::max(p->y+p->r,My);
+                mx = std::min(p.x-p.r,mx);
+                Mx = std::max(p.x+p.r,Mx);
+                my = std::min(p.y-p.r,my);
+                My = std::max(p.y+p.r,My);
+            }
+            if (p.isRectangle())
+            {
+                // the corners, the centre need not bound a rectangle
+                mx = std::min({p.llx,p.ulx,p.urx,p.lrx,mx});
+                Mx = std::max({p.llx,p.ulx,p.urx,p.lrx,Mx});
+                my = std::min({p.lly,p.uly,p.ury,p.lry,my});
+                My = std::max({p.lly,p.uly,p.ury,p.lry,My});
             }
         }
-        double x = Mx-mx;
-        double y = My-my;
+        Real x = Mx-mx;
+        Real y = My-my;
         this->radius = 0.5 * std::sqrt(x*x+y*y);
+        this->boundsX = 0.5 * (mx+Mx);
+        this->boundsY = 0.5 * (my+My);
     }
 
-    double CollisionMesh::momentOfInertia(double x, double y, double mass)
+    Real CollisionMesh::momentOfInertia(Real x, Real y, Real mass)
     {
 
-        double m = 0.0;
-        double dx = 0.0;
-        double dy = 0.0;
-        double me = mass/double(size());
+        Real m = 0.0;
+        Real dx = 0.0;
+        Real dy = 0.0;
+        Real me = mass/Real(size());
         // apply composite area method
         // assume non-overlapping
         // assume homogeneous mass for each piece
         for (unsigned i = 0; i < size(); i++)
         {
-            std::shared_ptr<CollisionPrimitive> c = worldVertices[i];
-            RectanglePrimitive * r = dynamic_cast<RectanglePrimitive*>(c.get());
+            CollisionPrimitive & c = worldVertices[i];
 
-            if (r == nullptr)
+            if (!c.isRectangle())
             {
                 // an overestimate, ignore holes
-                dx = c->x - x;
-                dy = c->y - y; 
-                m += me*0.5*c->r*c->r + me*(dx*dx+dy*dy);
+                dx = c.x - x;
+                dy = c.y - y; 
+                m += me*0.5*c.r*c.r + me*(dx*dx+dy*dy);
             }
             else
             {  
-                double h = r->height();
-                double w = r->width();
+                Real h = c.height();
+                Real w = c.width();
                 // an overestimate, ignore holes
-                dx = c->x - x;
-                dy = c->y - y; 
+                dx = c.x - x;
+                dy = c.y - y; 
                 m += me*0.08333333333333333 * (h*h+w*w) + me*(dx*dx+dy*dy);
             }
         }
@@ -0,0 +1,224 @@
+#include <Collision/contactBuffer.h>
+
+namespace Hop::System::Physics
+{
+
+    void ContactBuffer::clear()
+    {
+        nx.clear();
+        ny.clear();
+        overlap.clear();
+        scale.clear();
+        mass.clear();
+        friction.clear();
+        tangent.clear();
+        vx.clear();
+        vy.clear();
+        px.clear();
+        py.clear();
+        leverAX.clear();
+        leverAY.clear();
+        leverBX.clear();
+        leverBY.clear();
+
+        fax.clear();
+        fay.clear();
+        fbx.clear();
+        fby.clear();
+        tauA.clear();
+        tauB.clear();
+        fpx.clear();
+        fpy.clear();
+        active.clear();
+
+        i.clear();
+        j.clear();
+        pi.clear();
+        pj.clear();
+        type.clear();
+        a.clear();
+        b.clear();
+        ca.clear();
+        cb.clear();
+        flags.clear();
+    }
+
+    void ContactBuffer::add
+    (
+        const Id & idi, uint64_t particleI,
+        const Id & idj, uint64_t particleJ,
+        cPhysics * physicsA, cPhysics * physicsB,
+        CollisionPrimitive * primitiveA, CollisionPrimitive * primitiveB,
+        bool softA, bool softB,
+        ContactType t,
+        Real normalX, Real normalY, Real depth,
+        Real distanceScale,
+        Real effectiveMass, Real mu,
+        Real velocityX, Real velocityY,
+        Real pointX, Real pointY,
+        Real leverAx, Real leverAy,
+        Real leverBx, Real leverBy,
+        bool applyToPrimitives
+    )
+    {
+        nx.push_back(normalX);
+        ny.push_back(normalY);
+        overlap.push_back(depth);
+        scale.push_back(distanceScale);
+        mass.push_back(effectiveMass);
+        friction.push_back(mu);
+        tangent.push_back(t == ContactType::RECTANGLE ? -1.0 : 1.0);
+        vx.push_back(velocityX);
+        vy.push_back(velocityY);
+        px.push_back(pointX);
+        py.push_back(pointY);
+        leverAX.push_back(leverAx);
+        leverAY.push_back(leverAy);
+        leverBX.push_back(leverBx);
+        leverBY.push_back(leverBy);
+
+        fax.push_back(0.0);
+        fay.push_back(0.0);
+        fbx.push_back(0.0);
+        fby.push_back(0.0);
+        tauA.push_back(0.0);
+        tauB.push_back(0.0);
+        fpx.push_back(0.0);
+        fpy.push_back(0.0);
+        active.push_back(0);
+
+        i.push_back(idi);
+        j.push_back(idj);
+        pi.push_back(particleI);
+        pj.push_back(particleJ);
+        type.push_back(t);
+        a.push_back(physicsA);
+        b.push_back(physicsB);
+        ca.push_back(primitiveA);
+        cb.push_back(primitiveB);
+        flags.push_back(uint8_t(softA) | uint8_t(softB) << 1 | uint8_t(applyToPrimitives) << 2);
+    }
+
+    // swapped into an empty column, as a single worker's are
+    template <class T>
+    void appendColumn(std::vector<T> & to, std::vector<T> & from)
+    {
+        if (to.empty())
+        {
+            to.swap(from);
+            return;
+        }
+        to.insert(to.end(), from.begin(), from.end());
+    }
+
+    void ContactBuffer::append(ContactBuffer & other)
+    {
+        appendColumn(nx, other.nx);
+        appendColumn(ny, other.ny);
+        appendColumn(overlap, other.overlap);
+        appendColumn(scale, other.scale);
+        appendColumn(mass, other.mass);
+        appendColumn(friction, other.friction);
+        appendColumn(tangent, other.tangent);
+        appendColumn(vx, other.vx);
+        appendColumn(vy, other.vy);
+        appendColumn(px, other.px);
+        appendColumn(py, other.py);
+        appendColumn(leverAX, other.leverAX);
+        appendColumn(leverAY, other.leverAY);
+        appendColumn(leverBX, other.leverBX);
+        appendColumn(leverBY, other.leverBY);
+
+        appendColumn(fax, other.fax);
+        appendColumn(fay, other.fay);
+        appendColumn(fbx, other.fbx);
+        appendColumn(fby, other.fby);
+        appendColumn(tauA, other.tauA);
+        appendColumn(tauB, other.tauB);
+        appendColumn(fpx, other.fpx);
+        appendColumn(fpy, other.fpy);
+        appendColumn(active, other.active);
+
+        appendColumn(i, other.i);
+        appendColumn(j, other.j);
+        appendColumn(pi, other.pi);
+        appendColumn(pj, other.pj);
+        appendColumn(type, other.type);
+        appendColumn(a, other.a);
+        appendColumn(b, other.b);
+        appendColumn(ca, other.ca);
+        appendColumn(cb, other.cb);
+        appendColumn(flags, other.flags);
+
+        other.clear();
+    }
+
+    void ContactBuffer::apply()
+    {
+        /*
+            In insertion order, contacts come from the cell
+            list cell by cell so the objects and primitives
+            touched are mostly those just touched, and the sums
+            match forcing each pair as it is found.
+        */
+        for (size_t k = 0; k < size(); k++)
+        {
+            uint8_t f = flags[k];
+
+            // soft objects are forced through their primitives only
+
+            if (active[k])
+            {
+                if (!(f & 1))
+                {
+                    a[k]->fx += fax[k];
+                    a[k]->fy += fay[k];
+                    a[k]->tau -= tauA[k];
+                }
+
+                if (!(f & 2))
+                {
+                    b[k]->fx -= fbx[k];
+                    b[k]->fy -= fby[k];
+                    b[k]->tau += tauB[k];
+                }
+            }
+
+            if (f & 4)
+            {
+                if (f & 1)
+                {
+                    ca[k]->applyForce(fpx[k], fpy[k]);
+                }
+
+                if (f & 2)
+                {
+                    cb[k]->applyForce(-fpx[k], -fpy[k]);
+                }
+            }
+        }
+    }
+
+    Contact ContactBuffer::operator[](size_t k) const
+    {
+        Contact c;
+
+        c.i = i[k];
+        c.j = j[k];
+        c.pi = pi[k];
+        c.pj = pj[k];
+        c.type = type[k];
+        c.nx = nx[k];
+        c.ny = ny[k];
+        c.overlap = overlap[k];
+        c.px = px[k];
+        c.py = py[k];
+        c.vx = vx[k];
+        c.vy = vy[k];
+        c.fx = active[k] ? fax[k] : 0.0;
+        c.fy = active[k] ? fay[k] : 0.0;
+
+        return c;
+    }
+
+}
@@ -0,0 +1,280 @@
+#include <Collision/neighbourList.h>
+
+namespace Hop::System::Physics
+{
+
+    NeighbourList::NeighbourList(AbstractWorld * world, double skin)
+    : CellList(world), skin(skin), stale(true), builds(0)
+    {
+        margin = skin;
+        setRootNCells(std::max(1.0, std::floor(lX/(dx+skin))));
+    }
+
+    NeighbourList::NeighbourList
+    (
+        double skin,
+        uint64_t n,
+        tupled lx,
+        tupled ly
+    )
+    : CellList(n, lx, ly), skin(skin), stale(true), builds(0)
+    {
+        margin = skin;
+        setRootNCells(std::max(1.0, std::floor(lX/(dx+skin))));
+    }
+
+    void NeighbourList::centreOn(double x, double y)
+    {
+        tupled lastX = limX;
+        tupled lastY = limY;
+
+        CellList::centreOn(x, y);
+
+        if (limX != lastX || limY != lastY)
+        {
+            stale = true;
+        }
+    }
+
+    bool NeighbourList::needsBuild
+    (
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        CollideableView & objects
+    )
+    {
+        if
+        (
+            stale ||
+            dataC.getVersion() != builtVersionC ||
+            dataP.getVersion() != builtVersionP
+        )
+        {
+            return true;
+        }
+
+        double limit = 0.25*skin*skin;
+        double rx, ry;
+        uint64_t o = 0;
+
+        const std::vector<Id> & ids = objects.getIds();
+        const std::vector<uint64_t> & indexC = objects.indices<cCollideable>();
+        const std::vector<uint64_t> & indexP = objects.indices<cPhysics>();
+
+        for (uint64_t r = 0; r < ids.size(); r++)
+        {
+            bool binned = o < objectIds.size() && objectIds[o] == ids[r];
+
+            if (dataP.atIndex(indexP[r]).isGhost == binned)
+            {
+                return true;
+            }
+
+            if (!binned)
+            {
+                continue;
+            }
+
+            cCollideable & data = dataC.atIndex(indexC[r]);
+
+            uint64_t t = trackStart[o];
+
+            if (data.mesh.size() != trackStart[o+1]-t)
+            {
+                return true;
+            }
+
+            for (uint64_t i = 0; i < data.mesh.size(); i++)
+            {
+                const CollisionPrimitive & p = data.mesh[i];
+
+                rx = p.x-x0[t+i];
+                ry = p.y-y0[t+i];
+
+                if (rx*rx+ry*ry > limit)
+                {
+                    return true;
+                }
+            }
+
+            o++;
+        }
+
+        return false;
+    }
+
+    void NeighbourList::build
+    (
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        CollideableView & objects
+    )
+    {
+        populate(dataC, dataP, objects);
+
+        builtVersionC = dataC.getVersion();
+        builtVersionP = dataP.getVersion();
+
+        trackStart.clear();
+        x0.clear();
+        y0.clear();
+
+        for (uint64_t c : objectIndexC)
+        {
+            cCollideable & data = dataC.atIndex(c);
+
+            trackStart.push_back(x0.size());
+
+            for (uint64_t j = 0; j < data.mesh.size(); j++)
+            {
+                x0.push_back(data.mesh[j].x);
+                y0.push_back(data.mesh[j].y);
+            }
+        }
+
+        trackStart.push_back(x0.size());
+
+        neighbourStart.assign(size()+1, 0);
+        neighbours.clear();
+
+        uint64_t a, b;
+
+        for (uint64_t k = 0; k < size(); k++)
+        {
+            neighbourStart[k] = neighbours.size();
+
+            a = cell[k] / rootNCells;
+            b = cell[k] % rootNCells;
+
+            // the half stencil of CellList, visiting each pair once
+
+            cellNeighbours(k, a, b, dataC);
+            cellNeighbours(k, a+1, b+1, dataC);
+            cellNeighbours(k, a, b+1, dataC);
+            cellNeighbours(k, a+1, b, dataC);
+            cellNeighbours(k, a+1, b-1, dataC);
+        }
+
+        neighbourStart[size()] = neighbours.size();
+
+        stale = false;
+        builds++;
+    }
+
+    void NeighbourList::cellNeighbours
+    (
+        uint64_t k,
+        uint64_t a,
+        uint64_t b,
+        ComponentArray<cCollideable> & dataC
+    )
+    {
+        if (a >= rootNCells || b >= rootNCells)
+        {
+            return;
+        }
+
+        uint64_t c = a*rootNCells+b;
+        bool self = c == cell[k];
+
+        cCollideable & collidableI = dataC.atIndex(objectIndexC[object[k]]);
+        const CollisionPrimitive & ci = collidableI.mesh[id[k].second];
+
+        double rx, ry, rc;
+
+        for (uint64_t p = cellStart[c]; p < cellStart[c+1]; p++)
+        {
+            uint64_t j = cellIndex[p];
+
+            if (self && j <= k)
+            {
+                continue;
+            }
+
+            if (!boundsOverlap(object[k], object[j]))
+            {
+                continue;
+            }
+
+            if (id[j].first == id[k].first && collidableI.mesh.getIsRigid())
+            {
+                continue;
+            }
+
+            const CollisionPrimitive & cj = dataC.atIndex(objectIndexC[object[j]]).mesh[id[j].second];
+
+            rx = cj.x-ci.x;
+            ry = cj.y-ci.y;
+            rc = ci.r+cj.r+skin;
+
+            if (rx*rx+ry*ry < rc*rc)
+            {
+                neighbours.push_back(j);
+            }
+        }
+    }
+
+    void NeighbourList::handleObjectObjectCollisions(
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        CollisionResolver * resolver,
+        CollideableView & objects,
+        ThreadPool * workers
+    )
+    {
+        collided.clear();
+        contacts.clear();
+
+        clock.start();
+
+        if (needsBuild(dataC, dataP, objects))
+        {
+            build(dataC, dataP, objects);
+        }
+
+        clock.stop(timings.broadPhase);
+        clock.start();
+
+        for (uint64_t i = 0; i < size(); i++)
+        {
+            auto idi = id[i];
+            cCollideable & collidableI = dataC.atIndex(objectIndexC[object[i]]);
+            cPhysics & physicsI = dataP.atIndex(objectIndexP[object[i]]);
+
+            for (uint64_t n = neighbourStart[i]; n < neighbourStart[i+1]; n++)
+            {
+                uint64_t j = neighbours[n];
+                auto idj = id[j];
+                cCollideable & collidableJ = dataC.atIndex(objectIndexC[object[j]]);
+                cPhysics & physicsJ = dataP.atIndex(objectIndexP[object[j]]);
+
+                if (dormant(physicsI, physicsJ))
+                {
+                    continue;
+                }
+
+                bool c = resolver->findContacts(
+                    idi.first,idi.second,
+                    idj.first,idj.second,
+                    collidableI, collidableJ,
+                    physicsI, physicsJ,
+                    contacts
+                );
+
+                if (c)
+                {
+                    collided.insert(std::pair(idi.first,CollisionType(idj.first,false)));
+                    collided.insert(std::pair(idj.first,CollisionType(idi.first,false)));
+                }
+            }
+        }
+
+        resolver->evaluateContacts(contacts, 0, contacts.size());
+        contacts.apply();
+
+        collided.sort();
+
+        clock.stop(timings.narrowPhase);
+    }
+
+}
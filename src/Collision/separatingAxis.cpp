@@ -0,0 +1,171 @@
+#include <Collision/separatingAxis.h>
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace Hop::System::Physics
+{
+
+    bool rectanglesOverlap
+    (
+        const RectanglePrimitive & r1,
+        const RectanglePrimitive & r2,
+        Real & nx,
+        Real & ny,
+        Real & s
+    )
+    {
+        /*
+            One lane per axis: r1 axis1, r1 axis2, r2 axis1, r2 axis2.
+            Each corner is broadcast and projected onto all four in
+            one multiply-add, accumulating each rectangle's extent,
+            so only the final choice of axis is scalar. Operations
+            match Hop::Maths::axisOverlap so the result is identical.
+        */
+        const Real ax[4] = {r1.axis1x, r1.axis2x, r2.axis1x, r2.axis2x};
+        const Real ay[4] = {r1.axis1y, r1.axis2y, r2.axis1y, r2.axis2y};
+
+        Real overlap[4];
+
+#if defined(HOP_SINGLE_PRECISION) && defined(__SSE__)
+
+        const __m128 axisX = _mm_loadu_ps(ax);
+        const __m128 axisY = _mm_loadu_ps(ay);
+
+        auto project = [&](Real x, Real y)
+        {
+            return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(x), axisX), _mm_mul_ps(_mm_set1_ps(y), axisY));
+        };
+
+        __m128 ll = project(r1.llx, r1.lly);
+        __m128 ul = project(r1.ulx, r1.uly);
+        __m128 ur = project(r1.urx, r1.ury);
+        __m128 lr = project(r1.lrx, r1.lry);
+
+        __m128 m1 = _mm_min_ps(_mm_min_ps(ll, ul), _mm_min_ps(ur, lr));
+        __m128 M1 = _mm_max_ps(_mm_max_ps(ll, ul), _mm_max_ps(ur, lr));
+
+        ll = project(r2.llx, r2.lly);
+        ul = project(r2.ulx, r2.uly);
+        ur = project(r2.urx, r2.ury);
+        lr = project(r2.lrx, r2.lry);
+
+        __m128 m2 = _mm_min_ps(_mm_min_ps(ll, ul), _mm_min_ps(ur, lr));
+        __m128 M2 = _mm_max_ps(_mm_max_ps(ll, ul), _mm_max_ps(ur, lr));
+
+        _mm_storeu_ps(overlap, _mm_sub_ps(_mm_min_ps(M2, M1), _mm_max_ps(m1, m2)));
+
+#elif !defined(HOP_SINGLE_PRECISION) && defined(__AVX__)
+
+        const __m256d axisX = _mm256_loadu_pd(ax);
+        const __m256d axisY = _mm256_loadu_pd(ay);
+
+        auto project = [&](Real x, Real y)
+        {
+            return _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(x), axisX), _mm256_mul_pd(_mm256_set1_pd(y), axisY));
+        };
+
+        __m256d ll = project(r1.llx, r1.lly);
+        __m256d ul = project(r1.ulx, r1.uly);
+        __m256d ur = project(r1.urx, r1.ury);
+        __m256d lr = project(r1.lrx, r1.lry);
+
+        __m256d m1 = _mm256_min_pd(_mm256_min_pd(ll, ul), _mm256_min_pd(ur, lr));
+        __m256d M1 = _mm256_max_pd(_mm256_max_pd(ll, ul), _mm256_max_pd(ur, lr));
+
+        ll = project(r2.llx, r2.lly);
+        ul = project(r2.ulx, r2.uly);
+        ur = project(r2.urx, r2.ury);
+        lr = project(r2.lrx, r2.lry);
+
+        __m256d m2 = _mm256_min_pd(_mm256_min_pd(ll, ul), _mm256_min_pd(ur, lr));
+        __m256d M2 = _mm256_max_pd(_mm256_max_pd(ll, ul), _mm256_max_pd(ur, lr));
+
+        _mm256_storeu_pd(overlap, _mm256_sub_pd(_mm256_min_pd(M2, M1), _mm256_max_pd(m1, m2)));
+
+#elif !defined(HOP_SINGLE_PRECISION) && defined(__SSE2__)
+
+        // two lanes a pass, r1's axes then r2's
+        for (unsigned l = 0; l < 4; l += 2)
+        {
+            const __m128d axisX = _mm_loadu_pd(&ax[l]);
+            const __m128d axisY = _mm_loadu_pd(&ay[l]);
+
+            auto project = [&](Real x, Real y)
+            {
+                return _mm_add_pd(_mm_mul_pd(_mm_set1_pd(x), axisX), _mm_mul_pd(_mm_set1_pd(y), axisY));
+            };
+
+            __m128d ll = project(r1.llx, r1.lly);
+            __m128d ul = project(r1.ulx, r1.uly);
+            __m128d ur = project(r1.urx, r1.ury);
+            __m128d lr = project(r1.lrx, r1.lry);
+
+            __m128d m1 = _mm_min_pd(_mm_min_pd(ll, ul), _mm_min_pd(ur, lr));
+            __m128d M1 = _mm_max_pd(_mm_max_pd(ll, ul), _mm_max_pd(ur, lr));
+
+            ll = project(r2.llx, r2.lly);
+            ul = project(r2.ulx, r2.uly);
+            ur = project(r2.urx, r2.ury);
+            lr = project(r2.lrx, r2.lry);
+
+            __m128d m2 = _mm_min_pd(_mm_min_pd(ll, ul), _mm_min_pd(ur, lr));
+            __m128d M2 = _mm_max_pd(_mm_max_pd(ll, ul), _mm_max_pd(ur, lr));
+
+            _mm_storeu_pd(&overlap[l], _mm_sub_pd(_mm_min_pd(M2, M1), _mm_max_pd(m1, m2)));
+        }
+
+#else
+
+        // lane by lane, laid out for the compiler to vectorise (e.g. NEON)
+        Real m1[4], M1[4], m2[4], M2[4];
+
+        for (unsigned l = 0; l < 4; l++)
+        {
+            Real ll = r1.llx*ax[l] + r1.lly*ay[l];
+            Real ul = r1.ulx*ax[l] + r1.uly*ay[l];
+            Real ur = r1.urx*ax[l] + r1.ury*ay[l];
+            Real lr = r1.lrx*ax[l] + r1.lry*ay[l];
+
+            m1[l] = std::min(std::min(ll, ul), std::min(ur, lr));
+            M1[l] = std::max(std::max(ll, ul), std::max(ur, lr));
+
+            ll = r2.llx*ax[l] + r2.lly*ay[l];
+            ul = r2.ulx*ax[l] + r2.uly*ay[l];
+            ur = r2.urx*ax[l] + r2.ury*ay[l];
+            lr = r2.lrx*ax[l] + r2.lry*ay[l];
+
+            m2[l] = std::min(std::min(ll, ul), std::min(ur, lr));
+            M2[l] = std::max(std::max(ll, ul), std::max(ur, lr));
+        }
+
+        for (unsigned l = 0; l < 4; l++)
+        {
+            overlap[l] = std::min(M2[l], M1[l]) - std::max(m1[l], m2[l]);
+        }
+
+#endif
+
+        // disjoint extents give a negative overlap, touching zero
+        bool collided = (overlap[0] > 0.0) & (overlap[1] > 0.0) & (overlap[2] > 0.0) & (overlap[3] > 0.0);
+
+        unsigned k = 0;
+        k = overlap[1] < overlap[k] ? 1 : k;
+        k = overlap[2] < overlap[k] ? 2 : k;
+        k = overlap[3] < overlap[k] ? 3 : k;
+
+        nx = collided ? ax[k] : 0.0;
+        ny = collided ? ay[k] : 0.0;
+        s = collided ? overlap[k] : 0.0;
+
+        return collided;
+    }
+
+}
@@ -1,4 +1,5 @@
 #include <Collision/springDashpotResolver.h>
+#include <Util/lanes.h>
 #include <chrono>
 using namespace std::chrono;
 
@@ -12,14 +13,14 @@ namespace Hop::System::Physics
 
     using Hop::Maths::pointLineSegmentDistanceSquared;
     using Hop::Maths::pointLineHandedness;
-    using Hop::Maths::rectangleRectangleCollided;
     using Hop::Maths::sdf;
     using Hop::Maths::shortestDistanceSquared;
     using Hop::Maths::pointInRectangle;
+    using Hop::Maths::Rectangle;
 
     void SpringDashpot::updateParameters(
-        double tc,
-        double cor
+        Real tc,
+        Real cor
     )
     {
         collisionTime = tc;
@@ -28,119 +29,19 @@ namespace Hop::System::Physics
         beta = -std::log(cor) / tc;
     }
 
-    void SpringDashpot::springDashpotForceCircles
+    void SpringDashpot::springDashpotWallForceCircle
     (
-        cPhysics & pI, cPhysics & pJ,
-        double dd, double rx, double ry, double rc, double me,
-        double pxi, double pyi, double pxj, double pyj,
-        double & fx, double & fy
-    )
-    {
-        double mag, dinv, nx, ny, vrx, vry, ddot, d, dot, tau, nxt, nyt;
-
-        double kr = me*alpha;
-        double kd = 2.0*me*beta;
-
-        double friction = (pI.friction + pJ.friction)*0.5;
-
-        mag = 0.0;
-        d = std::sqrt(dd);
-        dinv = 1.0 / d;
-        nx = rx * dinv;
-        fx = nx;
-        ny = ry * dinv;
-        fy = ny;
-        dinv = std::min(3.0,dinv);
-
-        mag -= kr*(rc-d)*dinv;
-
-        vrx = pI.vx-pJ.vx;
-        vry = pI.vy-pJ.vy;
-
-        ddot = nx*vrx+ny*vry;
-
-        mag -= kd*ddot*dinv;
-
-        nxt = -ny;
-        nyt = nx;
-
-        dot = nxt*vrx + nyt*vry;
-
-        if (dot > 0.0){
-            nxt = -nxt;
-            nyt = -nyt;
-        }
-
-        // i -> j
-        mag = std::min(0.0, mag);
-
-        fx *= mag;
-        fy *= mag;
-
-        fx += friction*std::abs(mag)*nxt;
-        fy += friction*std::abs(mag)*nyt;
-
-        pI.fx += fx;
-        pI.fy += fy;
-
-        pJ.fx -= fx;
-        pJ.fy -= fy;
-
-        rx = pxi - pI.x;
-        ry = pyi - pI.y;
-
-        tau = (rx*fy-ry*fx);
-
-        // this magic non-linearity dampens 
-        //  angular oscillations...
-
-        if (std::abs(tau) < 0.01)
-        {
-            if (tau > 0)
-            {
-                tau = tau*tau; 
-            }
-            else
-            {
-                tau = -tau*tau;
-            }
-        }
-
-        pI.tau -= tau;
-
-        rx = pxj - pJ.x;
-        ry = pyj - pJ.y;
-
-        tau = (rx*fy-ry*fx);
-
-        if (std::abs(tau) < 0.01)
-        {
-            if (tau > 0)
-            {
-                tau = tau*tau; 
-            }
-            else
-            {
-                tau = -tau*tau;
-            }
-        }
-
-        pJ.tau += tau;
-    }
-
-     void SpringDashpot::springDashpotWallForceCircle
-    (
-        double nx,
-        double ny,
-        double d2,
-        double r,
-        double m,
-        double px, double py,
+        Real nx,
+        Real ny,
+        Real d2,
+        Real r,
+        Real m,
+        Real px, Real py,
         cPhysics & dataP,
-        double & fx, double & fy
+        Real & fx, Real & fy
     )
     {
-        double meff, kr, kd, d, vrx, vry, ddot, mag, rx, ry, nxt, nyt, dot, tau;
+        Real meff, kr, kd, d, vrx, vry, ddot, mag, rx, ry, nxt, nyt, dot, tau;
 
         meff = 1.0 / (1.0/m+1.0/(m*WALL_MASS_MULTIPLIER));
         kr = meff*alpha;
@@ -166,7 +67,7 @@ namespace Hop::System::Physics
         }
 
         // j -> i
-        mag = std::max(0.0, mag);
+        mag = std::max(Real(0.0), mag);
 
         fx = mag*nx;
         fy = mag*ny;
@@ -203,21 +104,21 @@ namespace Hop::System::Physics
     (
         cPhysics & pI,
         cPhysics & pJ,
-        double od, double nx, double ny,
-        double me,
-        double px, double py,
-        double & fx, double & fy
+        Real od, Real nx, Real ny,
+        Real me,
+        Real px, Real py,
+        Real & fx, Real & fy
     )
     {
-        double mag, magC, vrx, vry, ddot, rx, ry, dot, nxt, nyt, tau;
+        Real mag, magC, vrx, vry, ddot, rx, ry, dot, nxt, nyt, tau;
 
         mag = 0.0;
         magC = 0.0;
         fx = nx;
         fy = ny;
 
-        double kr = me*alpha;
-        double kd = 2.0*me*beta;
+        Real kr = me*alpha;
+        Real kd = 2.0*me*beta;
 
         mag = kr*od;
         magC = mag;
@@ -296,21 +197,20 @@ namespace Hop::System::Physics
 
     }
 
-    void SpringDashpot::collisionForce
+    void SpringDashpot::wallCollisionForce
     (
         cPhysics & pI, cPhysics & pJ,
         RectanglePrimitive * li,
-        RectanglePrimitive * lj,
-        bool wall
+        RectanglePrimitive * lj
     )
     {
-        double nx, ny, nxt, nyt, dt, s;
+        Real nx, ny, nxt, nyt, dt, s;
         bool collided = false;
 
-        double fx = 0.0;
-        double fy = 0.0;
+        Real fx = 0.0;
+        Real fy = 0.0;
 
-        collided = rectangleRectangleCollided<double>(li->getRect(),lj->getRect(),nx,ny,s);
+        collided = rectanglesOverlap(*li,*lj,nx,ny,s);
 
         if (!collided){ return; }
 
@@ -328,162 +228,258 @@ namespace Hop::System::Physics
             ny = -ny;
         }
 
-        if (wall)
-        {
+        Real me = 1.0 / (1.0/li->effectiveMass + 1.0/(li->effectiveMass*WALL_MASS_MULTIPLIER));
+
+        bool sdll = pointInRectangle<Real>(li->llx,li->lly,lj->getRect());
+        bool sdul = pointInRectangle<Real>(li->ulx,li->uly,lj->getRect());
+        bool sdur = pointInRectangle<Real>(li->urx,li->ury,lj->getRect());
+        bool sdlr = pointInRectangle<Real>(li->lrx,li->lry,lj->getRect());
 
-            double me = 1.0 / (1.0/li->effectiveMass + 1.0/(li->effectiveMass*WALL_MASS_MULTIPLIER));
+        unsigned fs = sdll+sdul+sdur+sdlr;
 
-            bool sdll = pointInRectangle<double>(li->llx,li->lly,lj->getRect());
-            bool sdul = pointInRectangle<double>(li->ulx,li->uly,lj->getRect());
-            bool sdur = pointInRectangle<double>(li->urx,li->ury,lj->getRect());
-            bool sdlr = pointInRectangle<double>(li->lrx,li->lry,lj->getRect());
+        if (fs == 0)
+        {
+            springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->x,li->y, fx, fy);
+        }
+        else
+        {
 
-            unsigned fs = sdll+sdul+sdur+sdlr;
+            //nx /= float(fs);
+            //ny /= float(fs);
 
-            if (fs == 0)
+            if (sdll)
             {
-                springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->x,li->y, fx, fy);
+                springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->llx,li->lly, fx, fy);
             }
-            else
+            if (sdul)
+            {
+                springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->ulx,li->uly, fx, fy);
+            }
+            if (sdur)
             {
+                springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->urx,li->ury, fx, fy);
+            }
+            if (sdlr)
+            {
+                springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->lrx,li->lry, fx, fy);
+            }
+        }
+        li->applyForce(fx, fy);
+        lj->applyForce(-fx, -fy);
+    }
 
-                //nx /= float(fs);
-                //ny /= float(fs);
+    bool SpringDashpot::handleObjectObjectCollision(
+        Id & objectI, uint64_t particleI,
+        Id & objectJ, uint64_t particleJ,
+        cCollideable & cI, cCollideable & cJ,
+        cPhysics & pI, cPhysics & pJ
+    )
+    {
+        immediate.clear();
+
+        bool collided = findContacts
+        (
+            objectI, particleI,
+            objectJ, particleJ,
+            cI, cJ,
+            pI, pJ,
+            immediate
+        );
 
-                if (sdll)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->llx,li->lly, fx, fy);
-                }
-                if (sdul)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->ulx,li->uly, fx, fy);
-                }
-                if (sdur)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->urx,li->ury, fx, fy);
-                }
-                if (sdlr)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->lrx,li->lry, fx, fy);
-                }
-            }
-            li->applyForce(fx, fy);
-            lj->applyForce(-fx, -fy);
+        evaluateContacts(immediate, 0, immediate.size());
+        immediate.apply();
+
+        return collided;
+    }
 
+    bool SpringDashpot::findContacts(
+        Id & objectI, uint64_t particleI,
+        Id & objectJ, uint64_t particleJ,
+        cCollideable & cI, cCollideable & cJ,
+        cPhysics & pI, cPhysics & pJ,
+        ContactBuffer & contacts
+    )
+    {
+        if (objectI == objectJ)
+        { 
+            if (cI.mesh.getIsRigid() || particleI == particleJ) 
+            { 
+                return false; 
+            }
         }
-        else
+
+        Real rx, ry, rc, dd;
+
+        rx = 0.0; ry = 0.0; rc = 0.0;
+
+        CollisionPrimitive * ci = &cI.mesh[particleI];
+        rx -= ci->x;
+        ry -= ci->y;
+        rc += ci->r;
+
+
+        CollisionPrimitive * cj = &cJ.mesh[particleJ];
+        rx += cj->x;
+        ry += cj->y;
+        rc += cj->r;
+
+        dd = rx*rx+ry*ry;
+
+        if (dd == 0.0)
         {
-            nxt = nx;
-            nyt = ny;
+            return true;
+        }
 
-            double me = 1.0 / (1.0/li->effectiveMass + 1.0/lj->effectiveMass);
+        bool collided = dd < rc*rc;
 
-            bool sdll = pointInRectangle<double>(li->llx,li->lly,lj->getRect());
-            bool sdul = pointInRectangle<double>(li->ulx,li->uly,lj->getRect());
-            bool sdur = pointInRectangle<double>(li->urx,li->ury,lj->getRect());
-            bool sdlr = pointInRectangle<double>(li->lrx,li->lry,lj->getRect());
+        if (collided)
+        {
+            ContactSide i {objectI, particleI, &pI, ci, !cI.mesh.getIsRigid()};
+            ContactSide j {objectJ, particleJ, &pJ, cj, !cJ.mesh.getIsRigid()};
 
-            unsigned fs = sdll+sdul+sdur+sdlr;
+            PairKernel kernel = pairKernels[uint8_t(ci->type)][uint8_t(cj->type)];
+            (this->*kernel)(contacts,i,j,rc,dd);
+        }
 
-            if (fs == 0)
-            {
-                springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->x,li->y, fx, fy);
-            }
-            else
-            {
+        if (objectI == objectJ)
+        {
+            return false;
+        }
+        else
+        {
+            return collided;
+        }
+    }
 
-                //nx /= float(fs);
-                //ny /= float(fs);
+    void SpringDashpot::rectangleContact
+    (
+        ContactBuffer & contacts,
+        const ContactSide & a,
+        const ContactSide & b,
+        Real od, Real nx, Real ny,
+        Real me,
+        Real px, Real py,
+        bool primitives
+    )
+    {
+        contacts.add
+        (
+            a.id, a.particle,
+            b.id, b.particle,
+            a.physics, b.physics,
+            a.primitive, b.primitive,
+            a.soft, b.soft,
+            ContactType::RECTANGLE,
+            nx, ny, od,
+            1.0,
+            me, 0.5,
+            a.physics->vx, a.physics->vy,
+            px, py,
+            px - a.physics->x, py - a.physics->y,
+            px - b.physics->x, py - b.physics->y,
+            primitives
+        );
+    }
 
-                if (sdll)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->llx,li->lly, fx, fy);
-                }
-                if (sdul)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->ulx,li->uly, fx, fy);
-                }
-                if (sdur)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->urx,li->ury, fx, fy);
-                }
-                if (sdlr)
-                {
-                    springDashpotForceRect(pI, pJ, s, -nx, -ny, me, li->lrx,li->lry, fx, fy);
-                }
+    void SpringDashpot::cornerContacts
+    (
+        ContactBuffer & contacts,
+        const ContactSide & a,
+        const ContactSide & b,
+        Real od, Real nx, Real ny,
+        Real me,
+        bool centrePrimitives
+    )
+    {
+        RectanglePrimitive * la = a.primitive;
+        Rectangle r = b.primitive->getRect();
 
-                li->applyForce(fx, fy);
-                lj->applyForce(-fx, -fy);
-            }
+        bool sdll = pointInRectangle<Real>(la->llx,la->lly,r);
+        bool sdul = pointInRectangle<Real>(la->ulx,la->uly,r);
+        bool sdur = pointInRectangle<Real>(la->urx,la->ury,r);
+        bool sdlr = pointInRectangle<Real>(la->lrx,la->lry,r);
 
-            fx = 0.0;
-            fy = 0.0;
+        if (!(sdll || sdul || sdur || sdlr))
+        {
+            rectangleContact(contacts, a, b, od, nx, ny, me, la->x, la->y, centrePrimitives);
+            return;
+        }
 
-            nx = nxt;
-            ny = nyt;
+        if (sdll)
+        {
+            rectangleContact(contacts, a, b, od, nx, ny, me, la->llx, la->lly, !(sdul || sdur || sdlr));
+        }
+        if (sdul)
+        {
+            rectangleContact(contacts, a, b, od, nx, ny, me, la->ulx, la->uly, !(sdur || sdlr));
+        }
+        if (sdur)
+        {
+            rectangleContact(contacts, a, b, od, nx, ny, me, la->urx, la->ury, !sdlr);
+        }
+        if (sdlr)
+        {
+            rectangleContact(contacts, a, b, od, nx, ny, me, la->lrx, la->lry, true);
+        }
+    }
 
-            sdll = pointInRectangle<double>(lj->llx,lj->lly,li->getRect());
-            sdul = pointInRectangle<double>(lj->ulx,lj->uly,li->getRect());
-            sdur = pointInRectangle<double>(lj->urx,lj->ury,li->getRect());
-            sdlr = pointInRectangle<double>(lj->lrx,lj->lry,li->getRect());
+    void SpringDashpot::rectangleContacts
+    (
+        ContactBuffer & contacts,
+        const ContactSide & i,
+        const ContactSide & j
+    )
+    {
+        RectanglePrimitive * li = i.primitive;
+        RectanglePrimitive * lj = j.primitive;
 
-            fs = sdll+sdul+sdur+sdlr;
+        Real nx, ny, nxt, nyt, dt, s;
 
-            if (fs == 0)
-            {
-                springDashpotForceRect(pJ, pI, s, nx, ny, me, lj->x,lj->y, fx, fy);
-            }
-            else
-            {
+        if (!rectanglesOverlap(*li,*lj,nx,ny,s))
+        {
+            return;
+        }
 
-                //nx /= float(fs);
-                //ny /= float(fs);
+        nxt = lj->x - li->x;
+        nyt = lj->y - li->y;
 
-                if (sdll)
-                {
-                    springDashpotForceRect(pJ, pI, s, nx, ny, me, lj->llx,lj->lly, fx, fy);
-                }
-                if (sdul)
-                {
-                    springDashpotForceRect(pJ, pI, s, nx, ny, me, lj->ulx,lj->uly, fx, fy);
-                }
-                if (sdur)
-                {
-                    springDashpotForceRect(pJ, pI, s, nx, ny, me, lj->urx,lj->ury, fx, fy);
-                }
-                if (sdlr)
-                {
-                    springDashpotForceRect(pJ, pI, s, nx, ny, me, lj->lrx,lj->lry, fx, fy);
-                }
-            }
+        dt = std::sqrt(nxt*nxt+nyt*nyt);
 
-            lj->applyForce(fx, fy);
-            li->applyForce(-fx, -fy);
+        nxt /= dt;
+        nyt /= dt;
+        
+        if (nx*nxt+ny*nyt < 0.0)
+        {
+            nx = -nx;
+            ny = -ny;
         }
 
+        Real me = 1.0 / (1.0/li->effectiveMass + 1.0/lj->effectiveMass);
+
+        cornerContacts(contacts, i, j, s, nx, ny, me, false);
+        cornerContacts(contacts, j, i, s, -nx, -ny, me, true);
     }
 
-    void SpringDashpot::collisionForce
+    void SpringDashpot::circleRectangleContacts
     (
-        cPhysics & pI, cPhysics & pJ,
-        CollisionPrimitive * c,
-        RectanglePrimitive * l,
-        double rx, double ry, double rc, double dd
+        ContactBuffer & contacts,
+        const ContactSide & c,
+        const ContactSide & l
     )
     {
-        double cx, cy, odod, nx, ny, nxt, nyt, dt, d;
+        CollisionPrimitive * pc = c.primitive;
+        RectanglePrimitive * pl = l.primitive;
 
-        double fx = 0.0;
-        double fy = 0.0;
+        Real cx, cy, odod, nx, ny, nxt, nyt, dt, d;
 
-        shortestDistanceSquared(c->x, c->y, l->getRect(), cx, cy, odod);
+        shortestDistanceSquared(pc->x, pc->y, pl->getRect(), cx, cy, odod);
 
         d = std::sqrt(odod);
-        nx = (cx-c->x)/d;
-        ny = (cy-c->y)/d;
+        nx = (cx-pc->x)/d;
+        ny = (cy-pc->y)/d;
 
-        nxt = l->x - c->x;
-        nyt = l->y - c->y;
+        nxt = pl->x - pc->x;
+        nyt = pl->y - pc->y;
 
         dt = std::sqrt(nxt*nxt+nyt*nyt);
 
@@ -496,188 +492,165 @@ namespace Hop::System::Physics
             ny = -ny;
         }
 
-
-        if (d < c->r)
+        if (d < pc->r)
         {
-            double me = 1.0 / (1.0/c->effectiveMass + 1.0/l->effectiveMass);
-            springDashpotForceRect(pI, pJ, c->r-d, -nx, -ny, me, cx, cy, fx, fy);
-            c->applyForce(fx, fy);
-            l->applyForce(-fx, -fy);
-            springDashpotForceRect(pJ, pI, c->r-d, nx, ny, me, cx, cy, fx, fy);
-            c->applyForce(-fx, -fy);
-            l->applyForce(fx, fy);
+            Real me = 1.0 / (1.0/pc->effectiveMass + 1.0/pl->effectiveMass);
+            rectangleContact(contacts, c, l, pc->r-d, nx, ny, me, cx, cy);
+            rectangleContact(contacts, l, c, pc->r-d, -nx, -ny, me, cx, cy);
         }
     }
 
-    /*
-        Circle - Circle collision is easy!
-    */
-    void SpringDashpot::collisionForce
+    void SpringDashpot::circleContacts
     (
-        cPhysics & pI, cPhysics & pJ,
-        CollisionPrimitive * c,
-        CollisionPrimitive * l,
-        double rx, double ry, double rc, double dd
+        ContactBuffer & contacts,
+        const ContactSide & i,
+        const ContactSide & j,
+        Real rc, Real dd
     )
     {
-        double nx, ny;
-        double fx = 0.0;
-        double fy = 0.0;
-        double me = 1.0 / (1.0/c->effectiveMass + 1.0/l->effectiveMass);
+        CollisionPrimitive * c = i.primitive;
+        CollisionPrimitive * l = j.primitive;
+        cPhysics & pI = *i.physics;
+        cPhysics & pJ = *j.physics;
+
+        Real me = 1.0 / (1.0/c->effectiveMass + 1.0/l->effectiveMass);
+
+        Real d = std::sqrt(dd);
+        Real dinv = 1.0 / d;
+
+        contacts.add
+        (
+            i.id, i.particle,
+            j.id, j.particle,
+            i.physics, j.physics,
+            c, l,
+            i.soft, j.soft,
+            ContactType::CIRCLE,
+            (l->x-c->x)*dinv, (l->y-c->y)*dinv, rc-d,
+            std::min(Real(3.0),dinv),
+            me, (pI.friction + pJ.friction)*0.5,
+            pI.vx-pJ.vx, pI.vy-pJ.vy,
+            c->x, c->y,
+            c->x - pI.x, c->y - pI.y,
+            l->x - pJ.x, l->y - pJ.y
+        );
+    }
 
-        nx = l->x-c->x;
-        ny = l->y-c->y;
+    // the non-linearity that dampens small torques' angular oscillations
+    template <class L>
+    inline L dampTorque(L tau)
+    {
+        L sq = tau*tau;
+        return select(abs(tau) < L::set(0.01), select(tau > L::set(0.0), sq, -sq), tau);
+    }
 
-        springDashpotForceCircles(pI,pJ,dd,nx,ny,rc,me,c->x,c->y,l->x,l->y,fx,fy);
+    /*
+        Spring dashpot forces of contacts [k, k+L::width). Normals
+        point from i to j. Circles are pushed apart by mag <= 0,
+        which rectangles (tangent < 0) take as is, and are inactive
+        when it is positive, separating.
+    */
+    template <class L>
+    inline void springDashpotContacts(ContactBuffer & c, size_t k, Real alpha, Real beta)
+    {
+        typedef typename L::Mask Mask;
 
-        c->applyForce(fx, fy);
-        l->applyForce(-fx, -fy);
+        const L zero = L::set(0.0);
+        const L two = L::set(2.0);
 
-    }
+        L nx = L::load(&c.nx[k]);
+        L ny = L::load(&c.ny[k]);
+        L vx = L::load(&c.vx[k]);
+        L vy = L::load(&c.vy[k]);
+        L s = L::load(&c.scale[k]);
+        L me = L::load(&c.mass[k]);
+        L t = L::load(&c.tangent[k]);
 
-    bool SpringDashpot::handleObjectObjectCollision(
-        Id & objectI, uint64_t particleI,
-        Id & objectJ, uint64_t particleJ,
-        cCollideable & cI, cCollideable & cJ,
-        cPhysics & pI, cPhysics & pJ
-    )
-    {
+        Mask rectangle = t < zero;
 
-        double fix = pI.fx;
-        double fiy = pI.fy;
-        double taui = pI.tau;
-        double fjx = pJ.fx;
-        double fjy = pJ.fy;
-        double tauj = pJ.tau;
-        
-        if (objectI == objectJ)
-        { 
-            if (cI.mesh.getIsRigid() || particleI == particleJ) 
-            { 
-                return false; 
-            }
-        }
+        L kr = me*L::set(alpha);
+        L kd = two*me*L::set(beta);
 
-        double rx, ry, rc, dd;
+        L spring = kr*L::load(&c.overlap[k]);
+        L ddot = nx*vx+ny*vy;
 
-        RectanglePrimitive * li, * lj;
+        L mag = zero-spring*s-kd*ddot*s;
 
-        rx = 0.0; ry = 0.0; rc = 0.0;
+        Mask separating = rectangle & (mag > zero);
 
-        std::shared_ptr<CollisionPrimitive> ci = cI.mesh[particleI];
-        rx -= ci->x;
-        ry -= ci->y;
-        rc += ci->r;
+        mag = select(rectangle, mag, min(mag, zero));
 
+        L tx = -ny*t;
+        L ty = nx*t;
 
-        std::shared_ptr<CollisionPrimitive> cj = cJ.mesh[particleJ];
-        rx += cj->x;
-        ry += cj->y;
-        rc += cj->r;
+        Mask flip = tx*vx+ty*vy > zero;
 
-        dd = rx*rx+ry*ry;
+        tx = select(flip, -tx, tx);
+        ty = select(flip, -ty, ty);
 
-        if (dd == 0.0)
-        {
-            return true;
-        }
+        L fx = nx*mag;
+        L fy = ny*mag;
 
-        bool collided = dd < rc*rc;
+        L tangential = L::load(&c.friction[k])*abs(mag);
 
-        if (collided)
-        {
-            li = dynamic_cast<RectanglePrimitive*>(ci.get());
-            lj = dynamic_cast<RectanglePrimitive*>(cj.get());
+        L fax = fx+tangential*tx;
+        L fay = fy+tangential*ty;
 
-            bool iIsRectangle = li != nullptr;
-            bool jIsRectangle = lj != nullptr;
+        // rectangles' torques come from the spring alone
+        L torqueX = select(rectangle, -nx*spring, fax);
+        L torqueY = select(rectangle, -ny*spring, fay);
 
-            if (iIsRectangle && jIsRectangle)
-            {
-                collisionForce(pI,pJ,li,lj);
-            }
-            else if (iIsRectangle && !jIsRectangle)
-            {
-                collisionForce(pJ,pI,cj.get(),li,rx,ry,rc,dd);
-            }
-            else if (!iIsRectangle && !jIsRectangle)
-            {
-                collisionForce(pI,pJ,ci.get(),cj.get(),rx,ry,rc,dd);
-            }
-            else if (!iIsRectangle && jIsRectangle)
-            {
-                collisionForce(pI,pJ,ci.get(),lj,rx,ry,rc,dd);
-            }
-        }
+        fax.store(&c.fax[k]);
+        fay.store(&c.fay[k]);
+        select(rectangle, fx, fax).store(&c.fbx[k]);
+        select(rectangle, fy, fay).store(&c.fby[k]);
 
-        if (!cI.mesh.getIsRigid())
-        {
-            pI.fx = fix;
-            pI.fy = fiy;
-            pI.tau = taui;
-        }
-        if (!cJ.mesh.getIsRigid())
-        {
-            pJ.fx = fjx;
-            pJ.fy = fjy;
-            pJ.tau = tauj;
-        }
+        dampTorque(L::load(&c.leverAX[k])*torqueY-L::load(&c.leverAY[k])*torqueX).store(&c.tauA[k]);
+        dampTorque(L::load(&c.leverBX[k])*torqueY-L::load(&c.leverBY[k])*torqueX).store(&c.tauB[k]);
 
-        if (objectI == objectJ)
-        {
-            return false;
-        }
-        else
+        // separating rectangles still hand their primitives the normal
+        select(separating, -nx, torqueX).store(&c.fpx[k]);
+        select(separating, -ny, torqueY).store(&c.fpy[k]);
+
+        int inactive = L::bits(separating);
+
+        for (unsigned l = 0; l < L::width; l++)
         {
-            return collided;
+            c.active[k+l] = !((inactive >> l) & 1);
         }
     }
 
-    void SpringDashpot::handleObjectWorldCollisions(
-        ComponentArray<cCollideable> & dataC,
-        ComponentArray<cPhysics> & dataP,
-        std::set<Id>::iterator start,
-        std::set<Id>::iterator end,
-        AbstractWorld * world
+    void SpringDashpot::evaluateContacts(
+        ContactBuffer & contacts,
+        size_t begin,
+        size_t end
     )
     {
-        
-        TileWorld * tw = dynamic_cast<TileWorld*>(world);
+        size_t k = begin;
 
-        if (tw != nullptr)
+        for (; k+Lanes::width <= end; k += Lanes::width)
         {
-            while (start != end)
-            {
-                cCollideable & c = dataC.get(*start);
-                cPhysics & p = dataP.get(*start);
+            springDashpotContacts<Lanes>(contacts, k, alpha, beta);
+        }
 
-                handleObjectWorldCollision(
-                    *start,
-                    c,
-                    p,
-                    tw
-                );
-                start++;
-            }
+        for (; k < end; k++)
+        {
+            springDashpotContacts<Lane>(contacts, k, alpha, beta);
         }
+    }
 
-        MarchingWorld * mw = dynamic_cast<MarchingWorld*>(world);
+    void SpringDashpot::prepareWorld(AbstractWorld * world)
+    {
+        preparedWorld = world;
 
-        if (mw != nullptr)
-        {
-            while (start != end)
-            {
-                cCollideable & c = dataC.get(*start);
-                cPhysics & p = dataP.get(*start);
+        tileWorld = dynamic_cast<TileWorld*>(world);
+        marchingWorld = dynamic_cast<MarchingWorld*>(world);
 
-                handleObjectWorldCollision(
-                    *start,
-                    c,
-                    p,
-                    mw
-                );
-                start++;
-            }
+        hardBoundary = nullptr;
+
+        if (world != nullptr && world->getBoundary()->isHard())
+        {
+            hardBoundary = dynamic_cast<Hop::World::FiniteBoundary<double>*>(world->getBoundary());
         }
     }
 
@@ -691,19 +664,22 @@ namespace Hop::System::Physics
 
         bool collided = false;
 
-        double fx = dataP.fx;
-        double fy = dataP.fy;
-        double tau = dataP.tau;
+        Real fx = dataP.fx;
+        Real fy = dataP.fy;
+        Real tau = dataP.tau;
 
-        TileWorld * tw = dynamic_cast<TileWorld*>(world);
+        if (world != preparedWorld)
+        {
+            prepareWorld(world);
+        }
 
-        if (tw != nullptr)
+        if (tileWorld != nullptr)
         {
             collided = handleObjectWorldCollision(
                 id,
                 dataC,
                 dataP,
-                tw
+                tileWorld
             );
 
             if (!dataC.mesh.getIsRigid())
@@ -716,15 +692,13 @@ namespace Hop::System::Physics
             return collided;
         }
         
-        MarchingWorld * mw = dynamic_cast<MarchingWorld*>(world);
-
-        if (mw != nullptr)
+        if (marchingWorld != nullptr)
         {
             collided = handleObjectWorldCollision(
                 id,
                 dataC,
                 dataP,
-                mw
+                marchingWorld
             );
 
             if (!dataC.mesh.getIsRigid())
@@ -746,6 +720,11 @@ namespace Hop::System::Physics
         TileWorld * world
     )
     {
+        if (world != preparedWorld)
+        {
+            prepareWorld(world);
+        }
+
         bool collided = false;
         double x0, y0, s;
         int i,j;
@@ -756,22 +735,18 @@ namespace Hop::System::Physics
         for (unsigned p = 0; p < dataC.mesh.size(); p++)
         {
 
-            std::shared_ptr<CollisionPrimitive> c = dataC.mesh[p];
+            CollisionPrimitive * c = &dataC.mesh[p];
 
-            if (world->getBoundary()->isHard())
+            if (hardBoundary != nullptr)
             {
-                Hop::World::FiniteBoundary<double> * fb = dynamic_cast<Hop::World::FiniteBoundary<double>*>(world->getBoundary());
-                if (fb != nullptr)
-                {
-                    hardBoundariesCollisionForce
-                    (
-                        c,
-                        dataP,
-                        *fb,
-                        world->worldUnitLength(),
-                        collided
-                    );
-                }
+                hardBoundariesCollisionForce
+                (
+                    c,
+                    dataP,
+                    *hardBoundary,
+                    world->worldUnitLength(),
+                    collided
+                );
             }
 
             if (world->pointOutOfBounds(c->x, c->y))
@@ -837,6 +812,11 @@ namespace Hop::System::Physics
         MarchingWorld * world
     )
     {
+        if (world != preparedWorld)
+        {
+            prepareWorld(world);
+        }
+
         bool collided = true;
         double x0, y0, s;
         int i,j;
@@ -847,22 +827,18 @@ namespace Hop::System::Physics
         for (unsigned p = 0; p < dataC.mesh.size(); p++)
         {
 
-            std::shared_ptr<CollisionPrimitive> c = dataC.mesh[p];
+            CollisionPrimitive * c = &dataC.mesh[p];
 
-            if (world->getBoundary()->isHard())
+            if (hardBoundary != nullptr)
             {
-                Hop::World::FiniteBoundary<double> * fb = dynamic_cast<Hop::World::FiniteBoundary<double>*>(world->getBoundary());
-                if (fb != nullptr)
-                {
-                    hardBoundariesCollisionForce
-                    (
-                        c,
-                        dataP,
-                        *fb,
-                        world->worldUnitLength(),
-                        collided
-                    );
-                }
+                hardBoundariesCollisionForce
+                (
+                    c,
+                    dataP,
+                    *hardBoundary,
+                    world->worldUnitLength(),
+                    collided
+                );
             }
 
             if (world->pointOutOfBounds(c->x, c->y))
@@ -914,7 +890,7 @@ namespace Hop::System::Physics
 
     void SpringDashpot::neighbourTilesCollision
     (
-        std::shared_ptr<CollisionPrimitive> c,
+        CollisionPrimitive * c,
         cPhysics & dataP,
         AbstractWorld * world,
         bool & collided
@@ -1231,7 +1207,7 @@ namespace Hop::System::Physics
         Tile & h,
         double x0,
         double y0,
-        std::shared_ptr<CollisionPrimitive> c,
+        CollisionPrimitive * c,
         cPhysics & dataP,
         double & hx,
         double & hy,
@@ -1254,9 +1230,9 @@ namespace Hop::System::Physics
         double insideThresh = thresh*thresh;
         int handedness, handedness2;
 
-        RectanglePrimitive * li = dynamic_cast<RectanglePrimitive*>(c.get());
+        bool isRectangle = c->isRectangle();
 
-        bool isRectangle = li != nullptr;
+        RectanglePrimitive * li = isRectangle ? c : nullptr;
 
         #pragma GCC diagnostic push                             
         #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
@@ -2028,8 +2004,8 @@ namespace Hop::System::Physics
         bool f1 = d2 < rr;
         bool f2 = op && (d2p < rr);
 
-        double fx = 0.0;
-        double fy = 0.0;
+        Real fx = 0.0;
+        Real fy = 0.0;
 
         if (li == nullptr)
         {
@@ -2061,15 +2037,15 @@ namespace Hop::System::Physics
             if (f1)
             {
                 collided = true;
-                collisionForce(dataP, dataA, li, &r1a, true);
+                wallCollisionForce(dataP, dataA, li, &r1a);
 
             }
 
             if ((f1 || f2) && bc)
             {
                 collided = true;
-                collisionForce(dataP, dataB, li, &r1b, true);
-                collisionForce(dataP, dataC, li, &r1c, true);
+                wallCollisionForce(dataP, dataB, li, &r1b);
+                wallCollisionForce(dataP, dataC, li, &r1c);
 
             }
 
@@ -2078,181 +2054,109 @@ namespace Hop::System::Physics
 
     void SpringDashpot::tileBoundariesCollision
     (
-        std::shared_ptr<CollisionPrimitive> c,
+        CollisionPrimitive * c,
         cPhysics & dataP,
         TileWorld * world,
         bool & collided
     )
     {
-        double nx, ny;
+        double nx = 0.0, ny = 0.0;
 
         double lx0, ly0, lx1, ly1;
 
         RectanglePrimitive r;
 
-        RectanglePrimitive * li = dynamic_cast<RectanglePrimitive*>(c.get());
+        RectanglePrimitive * li = c->isRectangle() ? c : nullptr;
 
         double rc = c->r*NEIGHBOUR_TILE_CHECK_ZONE_MULTIPLIER;
 
-        TileBoundsData tileBounds;
-
         double x0,y0,s;
         int i,j;
         Tile h;
 
         world->worldToTileData(c->x,c->y,h,x0,y0,s,i,j);
 
-        if (world->westBounds(c->x,c->y,rc,tileBounds,x0,y0,s,i,j))
+        if (s == 0.0)
         {
-            if 
-            (
-                tileBounds.wx0 != 0 &&
-                tileBounds.wx1 != 0 &&
-                tileBounds.wy0 != 0 &&
-                tileBounds.wy1 != 0
-            )
-            {
-                nx = 1.0; ny = 0.0;
-                lx0 = tileBounds.wx0; ly0 = tileBounds.wy0;
-                lx1 = tileBounds.wx1; ly1 = tileBounds.wy1;
-
-                r.llx = lx0-1.0; r.lly = ly0;
-                r.ulx = r.llx;   r.uly = ly1;
-                r.urx = lx0;     r.ury = ly1;
-                r.lrx = lx0;     r.lry = ly0;
-                r.resetAxes();
-
-                tileBoundariesCollisionForce
-                (
-                    c,
-                    dataP,
-                    li,
-                    r,
-                    lx0,
-                    ly0,
-                    lx1,
-                    ly1,
-                    nx,
-                    ny
-                );
-            }
+            // out of bounds
+            return;
         }
 
-        if (world->northBounds(c->x,c->y,rc,tileBounds,x0,y0,s,i,j))
-        {
-            if 
-            (
-                tileBounds.nx0 != 0 &&
-                tileBounds.nx1 != 0 &&
-                tileBounds.ny0 != 0 &&
-                tileBounds.ny1 != 0
-            )
-            {
-                nx = 0.0; ny = -1.0;
-                lx0 = tileBounds.nx0; ly0 = tileBounds.ny0;
-                lx1 = tileBounds.nx1; ly1 = tileBounds.ny1;
-
-                r.llx = lx0;     r.lly = ly0;
-                r.ulx = lx0;     r.uly = ly0+1.0;
-                r.urx = lx1;     r.ury = ly0+1.0;
-                r.lrx = lx1;     r.lry = ly0;
-                r.resetAxes();
+        TileSegment scratch[4];
+        uint8_t count;
 
-                tileBoundariesCollisionForce
-                (
-                    c,
-                    dataP,
-                    li,
-                    r,
-                    lx0,
-                    ly0,
-                    lx1,
-                    ly1,
-                    nx,
-                    ny
-                );
-            }
-        }
+        const TileSegment * segments = world->tileSegments(i,j,count,scratch);
 
-        // EAST
-        if (world->eastBounds(c->x,c->y,rc,tileBounds,x0,y0,s,i,j))
+        for (uint8_t k = 0; k < count; k++)
         {
-            if 
-            (
-                tileBounds.ex0 != 0 &&
-                tileBounds.ex1 != 0 &&
-                tileBounds.ey0 != 0 &&
-                tileBounds.ey1 != 0
-            )
-            {
-                nx = -1.0; ny = 0.0;
-                lx0 = tileBounds.ex0; ly0 = tileBounds.ey0;
-                lx1 = tileBounds.ex1; ly1 = tileBounds.ey1;
+            const TileSegment & l = segments[k];
 
-                r.llx = lx0;     r.lly = ly0;
-                r.ulx = lx0;     r.uly = ly0+1.0;
-                r.urx = lx0+1.0; r.ury = ly0+1.0;
-                r.lrx = lx0+1.0; r.lry = ly0;
-                r.resetAxes();
+            bool vertical = l.side == TileSide::WEST || l.side == TileSide::EAST;
 
-                tileBoundariesCollisionForce
-                (
-                    c,
-                    dataP,
-                    li,
-                    r,
-                    lx0,
-                    ly0,
-                    lx1,
-                    ly1,
-                    nx,
-                    ny
-                );
+            double dd = l.plane-(vertical ? c->x : c->y);
+            dd *= dd;
+            if (dd > rc*rc)
+            {
+                continue;
             }
-        }
 
-        // SOUTH
-
-        if (world->southBounds(c->x,c->y,rc,tileBounds,x0,y0,s,i,j))
-        {
-            if 
+            lx0 = l.x0; ly0 = l.y0;
+            lx1 = l.x1; ly1 = l.y1;
+
+            // the solid behind the segment, for rectangles
+            switch (l.side)
+            {
+                case TileSide::WEST:
+                    nx = 1.0; ny = 0.0;
+                    r.llx = lx0-1.0; r.lly = ly0;
+                    r.ulx = r.llx;   r.uly = ly1;
+                    r.urx = lx0;     r.ury = ly1;
+                    r.lrx = lx0;     r.lry = ly0;
+                    break;
+                case TileSide::NORTH:
+                    nx = 0.0; ny = -1.0;
+                    r.llx = lx0;     r.lly = ly0;
+                    r.ulx = lx0;     r.uly = ly0+1.0;
+                    r.urx = lx1;     r.ury = ly0+1.0;
+                    r.lrx = lx1;     r.lry = ly0;
+                    break;
+                case TileSide::EAST:
+                    nx = -1.0; ny = 0.0;
+                    r.llx = lx0;     r.lly = ly0;
+                    r.ulx = lx0;     r.uly = ly0+1.0;
+                    r.urx = lx0+1.0; r.ury = ly0+1.0;
+                    r.lrx = lx0+1.0; r.lry = ly0;
+                    break;
+                case TileSide::SOUTH:
+                    nx = 0.0; ny = 1.0;
+                    r.llx = lx0;     r.lly = ly0;
+                    r.ulx = lx1;     r.uly = ly0;
+                    r.urx = lx1;     r.ury = ly0-1.0;
+                    r.lrx = lx0;     r.lry = ly0-1.0;
+                    break;
+            }
+
+            r.resetAxes();
+
+            tileBoundariesCollisionForce
             (
-                tileBounds.sx0 != 0 &&
-                tileBounds.sx1 != 0 &&
-                tileBounds.sy0 != 0 &&
-                tileBounds.sy1 != 0
-            )
-            {
-                nx = 0.0; ny = 1.0;
-                lx0 = tileBounds.sx0; ly0 = tileBounds.sy0;
-                lx1 = tileBounds.sx1; ly1 = tileBounds.sy1;
-
-                r.llx = lx0;     r.lly = ly0;
-                r.ulx = lx1;     r.uly = ly0;
-                r.urx = lx1;     r.ury = ly0-1.0;
-                r.lrx = lx0;     r.lry = ly0-1.0;
-                r.resetAxes();
-
-                tileBoundariesCollisionForce
-                (
-                    c,
-                    dataP,
-                    li,
-                    r,
-                    lx0,
-                    ly0,
-                    lx1,
-                    ly1,
-                    nx,
-                    ny
-                );
-            }
+                c,
+                dataP,
+                li,
+                r,
+                lx0,
+                ly0,
+                lx1,
+                ly1,
+                nx,
+                ny
+            );
         }
     }
 
     bool SpringDashpot::tileBoundariesCollisionForce
     (
-        std::shared_ptr<CollisionPrimitive> c,
+        CollisionPrimitive * c,
         cPhysics & dataP,
         RectanglePrimitive * li,
         RectanglePrimitive r,
@@ -2264,8 +2168,8 @@ namespace Hop::System::Physics
         double ny
     )
     {
-        double fx = 0.0;
-        double fy = 0.0;
+        Real fx = 0.0;
+        Real fy = 0.0;
         double r2 = c->r*c->r;
 
         if (li == nullptr)
@@ -2287,32 +2191,32 @@ namespace Hop::System::Physics
         else
         {
             cPhysics dataTmp(0.,0.,0.);
-            collisionForce(dataP, dataTmp, li, &r, true);
+            wallCollisionForce(dataP, dataTmp, li, &r);
         }
         return false;
     }
 
     void SpringDashpot::hardBoundariesCollisionForce
     (
-        std::shared_ptr<CollisionPrimitive> c,
+        CollisionPrimitive * c,
         cPhysics & dataP,
-        Hop::World::FiniteBoundary<double> bounds,
+        const Hop::World::FiniteBoundary<double> & bounds,
         float lengthScale,
         bool & collided
     )
     {
-        double fx = 0.0;
-        double fy = 0.0;
-        double r2 = c->r*c->r;
+        Real fx = 0.0;
+        Real fy = 0.0;
+        Real r2 = c->r*c->r;
 
-        double mx = bounds.getMinX()*lengthScale;
-        double Mx = bounds.getMaxX()*lengthScale;
-        double my = bounds.getMinY()*lengthScale;
-        double My = bounds.getMaxY()*lengthScale;
+        Real mx = bounds.getMinX()*lengthScale;
+        Real Mx = bounds.getMaxX()*lengthScale;
+        Real my = bounds.getMinY()*lengthScale;
+        Real My = bounds.getMaxY()*lengthScale;
 
         if(bounds.isHardLeft() && std::abs(c->x - mx) < c->r)
         {
-            double d2 = pointLineSegmentDistanceSquared<double>
+            Real d2 = pointLineSegmentDistanceSquared<Real>
             (
                 c->x,c->y,
                 mx, my,
@@ -2329,7 +2233,7 @@ namespace Hop::System::Physics
 
         if(bounds.isHardRight() && std::abs(c->x - Mx) < c->r)
         {
-            double d2 = pointLineSegmentDistanceSquared<double>
+            Real d2 = pointLineSegmentDistanceSquared<Real>
             (
                 c->x,c->y,
                 Mx, my,
@@ -2346,7 +2250,7 @@ namespace Hop::System::Physics
 
         if(bounds.isHardBottom() && std::abs(c->y - my) < c->r)
         {
-            double d2 = pointLineSegmentDistanceSquared<double>
+            Real d2 = pointLineSegmentDistanceSquared<Real>
             (
                 c->x,c->y,
                 mx, my,
@@ -2363,7 +2267,7 @@ namespace Hop::System::Physics
         
         if(bounds.isHardTop() && std::abs(c->y - My) < c->r)
         {
-            double d2 = pointLineSegmentDistanceSquared<double>
+            Real d2 = pointLineSegmentDistanceSquared<Real>
             (
                 c->x,c->y,
                 mx, My,
@@ -87,4 +87,51 @@ namespace Hop
 
         return 0;
     }
+
+    int lua_setCollisionDetector(lua_State * lua)
+    {
+        LuaString type;
+        LuaNumber skin;
+
+        int n = lua_gettop(lua);
+
+        if (n < 1 || n > 2 || !lua_isstring(lua, 1))
+        {
+            lua_pushliteral(lua,"expected detector, \"cellList\" or \"neighbourList\", and optionally a skin as argument");
+            return lua_error(lua);
+        }
+
+        type.read(lua, 1);
+
+        LuaExtraSpace * store = *static_cast<LuaExtraSpace**>(lua_getextraspace(lua));
+
+        if (type.characters == "cellList")
+        {
+            store->resolver->setDetector
+            (
+                std::make_unique<Hop::System::Physics::CellList>(store->world)
+            );
+        }
+        else if (type.characters == "neighbourList")
+        {
+            skin.n = 0.25*store->world->worldMaxCollisionPrimitiveSize();
+
+            if (n == 2)
+            {
+                skin.read(lua, 2);
+            }
+
+            store->resolver->setDetector
+            (
+                std::make_unique<Hop::System::Physics::NeighbourList>(store->world, skin.n)
+            );
+        }
+        else
+        {
+            lua_pushliteral(lua, "unknown detector, expected \"cellList\" or \"neighbourList\"");
+            return lua_error(lua);
+        }
+
+        return 0;
+    }
 }
\ No newline at end of file
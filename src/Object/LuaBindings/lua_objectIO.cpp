@@ -225,7 +225,7 @@ namespace Hop::Object
             if (collisionMesh.size() > 0)
             {
                 bool goodInput = false;
-                std::vector<std::shared_ptr<CollisionPrimitive>> mesh;
+                std::vector<CollisionPrimitive> mesh;
                 for (unsigned i = 0; i < collisionMesh.size(); i++)
                 {
                     if (collisionMesh[i].size() == 3 || collisionMesh[i].size() == 4)
@@ -233,7 +233,7 @@ namespace Hop::Object
                         uint64_t tag = collisionMesh[i].size() == 4 ? collisionMesh[i][3] : 0;
                         mesh.push_back
                         (
-                            std::make_shared<CollisionPrimitive>
+                            CollisionPrimitive
                             (
                                 collisionMesh[i][0],
                                 collisionMesh[i][1],
@@ -251,7 +251,7 @@ namespace Hop::Object
                         uint64_t tag = collisionMesh[i].size() == 9 ? collisionMesh[i][8] : 0;
                         mesh.push_back
                         (
-                            std::make_shared<RectanglePrimitive>
+                            RectanglePrimitive
                             (
                                 collisionMesh[i][0],
                                 collisionMesh[i][1],
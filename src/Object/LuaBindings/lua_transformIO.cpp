@@ -102,6 +102,8 @@ namespace Hop::Object
                 cCollideable & c = getComponent<cCollideable>(id);
                 c.mesh.transform(t);
             }
+
+            getSystem<sPhysics>().wake(this, id);
         }
 
         return 0;
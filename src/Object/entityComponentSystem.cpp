@@ -6,7 +6,7 @@ namespace Hop::Object
     {
         std::shared_ptr<Object> o = std::make_shared<Object>();
         objects[o->id] = o;
-        idToSignature[o->id] = Signature();
+        record(o->id).signature = Signature();
         //handleToId[Hop::Object::to_string(o->id)] = o->id;
 
         return o->id;
@@ -17,7 +17,7 @@ namespace Hop::Object
         std::shared_ptr<Object> o = std::make_shared<Object>();
 
         objects[o->id] = o;
-        idToSignature[o->id] = Signature();
+        record(o->id).signature = Signature();
 
         handleToId[handle] = o->id;
 
@@ -28,11 +28,15 @@ namespace Hop::Object
     {
         for (auto & component : componentData)
         {
-            component.second->remove(id);
+            if (component != nullptr)
+            {
+                component->remove(id);
+            }
         }
-        idToSignature[id] = Signature(0);
-        systemManager.objectSignatureChanged(id,idToSignature[id]);
-        idToSignature.erase(id);
+        Signature & s = record(id).signature;
+        changeArchetype(id,s,Signature(0));
+        s = Signature(0);
+        systemManager.objectSignatureChanged(id,s);
         objects.erase(id);
 
         for (auto handle : handleToId)
@@ -48,6 +52,93 @@ namespace Hop::Object
 
     void EntityComponentSystem::remove(std::string handle){}
 
+    void EntityComponentSystem::changeArchetype(const Id & i, const Signature & was, const Signature & is)
+    {
+        if (storage != Storage::ARCHETYPES || was == is)
+        {
+            return;
+        }
+
+        // created first, it may add blocks
+        uint32_t b = getArchetype(is);
+
+        if (was.any())
+        {
+            std::vector<Id> & ids = archetypes[getArchetype(was)].ids;
+            uint64_t row = record(i).row;
+
+            ids[row] = ids.back();
+            record(ids[row]).row = row;
+            ids.pop_back();
+        }
+
+        if (b != NO_ARCHETYPE)
+        {
+            record(i).row = archetypes[b].ids.size();
+            archetypes[b].ids.push_back(i);
+        }
+
+        unarranged |= was | is;
+    }
+
+    uint32_t EntityComponentSystem::getArchetype(const Signature & s)
+    {
+        if (s.none())
+        {
+            return NO_ARCHETYPE;
+        }
+
+        auto it = archetypeIndex.find(s);
+
+        if (it != archetypeIndex.end())
+        {
+            return it->second;
+        }
+
+        uint32_t a = archetypes.size();
+
+        archetypes.push_back({s, {}, {}});
+        archetypeIndex[s] = a;
+
+        for (uint32_t c = 0; c < MAX_COMPONENTS; c++)
+        {
+            if (s[c])
+            {
+                blocks[c].push_back(a);
+            }
+        }
+
+        return a;
+    }
+
+    void EntityComponentSystem::arrange()
+    {
+        if (unarranged.none())
+        {
+            return;
+        }
+
+        for (uint32_t c = 0; c < MAX_COMPONENTS; c++)
+        {
+            if (!unarranged[c] || componentData[c] == nullptr)
+            {
+                continue;
+            }
+
+            order.clear();
+
+            for (uint32_t a : blocks[c])
+            {
+                archetypes[a].start[c] = order.size();
+                order.insert(order.end(), archetypes[a].ids.begin(), archetypes[a].ids.end());
+            }
+
+            componentData[c]->arrange(order);
+        }
+
+        unarranged.reset();
+    }
+
     // do nothing callback
     void identityCallback(Id & i, Id & j){return;}
 
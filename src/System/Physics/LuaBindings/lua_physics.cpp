@@ -26,4 +26,100 @@ namespace Hop::System::Physics
         return 0;
     }
 
-}
\ No newline at end of file
+    int sPhysics::lua_setSleeping(lua_State * lua)
+    {
+        LuaNumber e, steps;
+
+        int n = lua_gettop(lua);
+
+        if (n < 1 || n > 3 || !lua_isboolean(lua, 1))
+        {
+            lua_pushliteral(lua,"expected sleeping (bool), and optionally energy and steps, as argument");
+            return lua_error(lua);
+        }
+
+        bool s = lua_toboolean(lua, 1);
+
+        e.n = sleepEnergy;
+        steps.n = sleepSteps;
+
+        if (n >= 2)
+        {
+            e.read(lua, 2);
+        }
+
+        if (n == 3)
+        {
+            steps.read(lua, 3);
+        }
+
+        setSleeping(s, e, unsigned(steps.n));
+
+        return 0;
+    }
+
+    int sPhysics::lua_setAdaptive(lua_State * lua)
+    {
+        int n = lua_gettop(lua);
+
+        if (n < 1 || n > 6 || !lua_isboolean(lua, 1))
+        {
+            lua_pushliteral(lua,"expected adaptive (bool), and optionally frameTime, maxSubSamples, budget, maxMovement and stepsPerCollision, as argument");
+            return lua_error(lua);
+        }
+
+        bool a = lua_toboolean(lua, 1);
+
+        AdaptiveTimeStep l = limits;
+        l.frameTime = dt*subSamples;
+
+        LuaNumber v;
+
+        if (n >= 2) { v.read(lua, 2); l.frameTime = v; }
+        if (n >= 3) { v.read(lua, 3); l.maxSubSamples = unsigned(v.n); }
+        if (n >= 4) { v.read(lua, 4); l.budget = v; }
+        if (n >= 5) { v.read(lua, 5); l.maxMovement = v; }
+        if (n == 6) { v.read(lua, 6); l.stepsPerCollision = v; }
+
+        if (l.frameTime <= 0.0 || l.maxMovement <= 0.0 || l.stepsPerCollision <= 0.0)
+        {
+            lua_pushliteral(lua,"frameTime, maxMovement and stepsPerCollision must be positive");
+            return lua_error(lua);
+        }
+
+        setAdaptive(a, l);
+
+        return 0;
+    }
+
+    int sPhysics::lua_timeStep(lua_State * lua)
+    {
+        lua_createtable(lua, 0, 11);
+
+        lua_pushnumber(lua, dt);
+        lua_setfield(lua, -2, "timeStep");
+        lua_pushinteger(lua, subSamples);
+        lua_setfield(lua, -2, "subSamples");
+        lua_pushinteger(lua, softBodySubCycles);
+        lua_setfield(lua, -2, "softBodySubCycles");
+        lua_pushboolean(lua, adaptive);
+        lua_setfield(lua, -2, "adaptive");
+        lua_pushnumber(lua, stableDt);
+        lua_setfield(lua, -2, "stableTimeStep");
+        lua_pushnumber(lua, limits.frameTime);
+        lua_setfield(lua, -2, "frameTime");
+        lua_pushinteger(lua, limits.maxSubSamples);
+        lua_setfield(lua, -2, "maxSubSamples");
+        lua_pushnumber(lua, limits.budget);
+        lua_setfield(lua, -2, "budget");
+        lua_pushnumber(lua, limits.maxMovement);
+        lua_setfield(lua, -2, "maxMovement");
+        lua_pushnumber(lua, limits.stepsPerCollision);
+        lua_setfield(lua, -2, "stepsPerCollision");
+        lua_pushnumber(lua, subStepCost);
+        lua_setfield(lua, -2, "subStepCost");
+
+        return 1;
+    }
+
+}
@@ -0,0 +1,110 @@
+#include <System/Physics/rigidBodies.h>
+#include <Util/lanes.h>
+
+namespace Hop::System::Physics
+{
+
+    void RigidBodies::clear()
+    {
+        resize(0);
+    }
+
+    void RigidBodies::resize(size_t n)
+    {
+        transforms.resize(n);
+        physics.resize(n);
+    }
+
+    /*
+        Bodies [i, end) from t and p, L::width at a time while
+        whole lanes remain. Returns the first body not stepped.
+    */
+    template <class L>
+    inline size_t verletLanes
+    (
+        cTransform * const * t,
+        cPhysics * const * p,
+        size_t i,
+        size_t end,
+        Real dt,
+        Real dtdt
+    )
+    {
+        constexpr unsigned w = L::width;
+
+        const L one = L::set(1.0);
+        const L two = L::set(2.0);
+
+        Real x[w], y[w], lastX[w], lastY[w], fx[w], fy[w], mass[w], drag[w];
+        Real vx[w], vy[w], nextX[w], nextY[w];
+
+        for (; i+w <= end; i += w)
+        {
+            for (unsigned l = 0; l < w; l++)
+            {
+                x[l] = t[i+l]->x;
+                y[l] = t[i+l]->y;
+                lastX[l] = p[i+l]->lastX;
+                lastY[l] = p[i+l]->lastY;
+                fx[l] = p[i+l]->fx;
+                fy[l] = p[i+l]->fy;
+                mass[l] = p[i+l]->mass;
+                drag[l] = p[i+l]->translationalDrag;
+            }
+
+            L m = L::load(mass);
+
+            L ct = L::load(drag)*L::set(dt)/(two*m);
+            L bt = one/(one+ct);
+            L at = (one-ct)*bt;
+
+            L lx = L::load(lastX);
+            L ly = L::load(lastY);
+
+            L nx = two*bt*L::load(x)-at*lx+bt*L::load(fx)*L::set(dtdt)/m;
+            L ny = two*bt*L::load(y)-at*ly+bt*L::load(fy)*L::set(dtdt)/m;
+
+            ((nx-lx)/L::set(dt*Real(2.0))).store(vx);
+            ((ny-ly)/L::set(dt*Real(2.0))).store(vy);
+
+            nx.store(nextX);
+            ny.store(nextY);
+
+            for (unsigned l = 0; l < w; l++)
+            {
+                cTransform & dataT = *t[i+l];
+                cPhysics & dataP = *p[i+l];
+
+                dataP.vx = vx[l];
+                dataP.vy = vy[l];
+
+                dataP.lastX = x[l];
+                dataP.lastY = y[l];
+
+                dataP.fx = 0.0;
+                dataP.fy = 0.0;
+
+                dataP.x = nextX[l];
+                dataP.y = nextY[l];
+
+                dataT.x = nextX[l];
+                dataT.y = nextY[l];
+            }
+        }
+
+        return i;
+    }
+
+    void RigidBodies::integrate
+    (
+        Real dt,
+        Real dtdt,
+        size_t begin,
+        size_t end
+    )
+    {
+        size_t i = verletLanes<Lanes>(transforms.data(), physics.data(), begin, end, dt, dtdt);
+        verletLanes<Lane>(transforms.data(), physics.data(), i, end, dt, dtdt);
+    }
+
+}
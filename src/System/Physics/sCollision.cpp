@@ -13,12 +13,13 @@ namespace Hop::System::Physics
 
         ComponentArray<cCollideable> & dataC = m->getComponentArray<cCollideable>();
         ComponentArray<cPhysics> & dataP = m->getComponentArray<cPhysics>();
+        CollideableView & collideable = m->view<cPhysics, cCollideable>();
 
         detector->handleObjectObjectCollisions(
             dataC,
             dataP,
             resolver.get(),
-            objects,
+            collideable,
             workers
         );
 
@@ -27,7 +28,7 @@ namespace Hop::System::Physics
             dataP,
             resolver.get(),
             w,
-            objects,
+            collideable,
             workers
         );
 
@@ -10,18 +10,158 @@ namespace Hop::System::Physics
     (
         EntityComponentSystem * m, 
         sCollision * collisions,
-        AbstractWorld * world
+        AbstractWorld * world,
+        ThreadPool * workers
     )
     {
+        // so the cell list, views and chunks walk archetype order
+        m->arrange();
+
+        if (adaptive)
+        {
+            chooseTimeStep(m, collisions);
+        }
+
+        high_resolution_clock::time_point t0 = high_resolution_clock::now();
+
         for (unsigned k = 0 ; k < subSamples; k++)
         {
 
-            collisions->update(m, world);
+            collisions->update(m, world, workers);
+
+            if (sleeping)
+            {
+                wakeOnContact(m, collisions);
+            }
+
+            clock.start();
+
             gravityForce(m);
-            update(m);
+            update(m, workers);
+
+            clock.stop(timings.integration);
+
+            if (sleeping)
+            {
+                sleepIslands(collisions);
+            }
+        }
+
+        if (adaptive && limits.budget > 0.0)
+        {
+            double cost = duration_cast<duration<double>>(high_resolution_clock::now()-t0).count()/subSamples;
+            subStepCost = subStepCost == 0.0 ? cost : 0.9*subStepCost+0.1*cost;
         }
     }
 
+    Real sPhysics::stableTimeStep(EntityComponentSystem * m, sCollision * collisions)
+    {
+        // fastest primitive, in radii per unit time
+        Real rate = 0.0;
+        Real tc = collisions->getCollisionTime();
+
+        m->view<cPhysics, cTransform, cCollideable>().each
+        (
+            [&](const Id &, cPhysics & dataP, cTransform &, cCollideable & data)
+            {
+                if (dataP.isAsleep || !dataP.isMoveable)
+                {
+                    return;
+                }
+
+                CollisionMesh & mesh = data.mesh;
+
+                // a primitive moves with the body and its rotation about it
+                Real v = std::sqrt(dataP.vx*dataP.vx+dataP.vy*dataP.vy)+std::abs(dataP.phi)*mesh.getRadius();
+
+                for (size_t i = 0; i < mesh.size(); i++)
+                {
+                    const CollisionPrimitive & c = mesh[i];
+
+                    if (c.r > 0.0)
+                    {
+                        rate = std::max(rate, (v+std::sqrt(c.vx*c.vx+c.vy*c.vy))/c.r);
+                    }
+
+                    if (c.stiffness < CollisionPrimitive::RIGID)
+                    {
+                        // half a period of the primitive's spring, sub cycled
+                        tc = std::min(tc, Real(softBodySubCycles*M_PI*std::sqrt(c.effectiveMass/c.stiffness)));
+                    }
+                }
+            }
+        );
+
+        Real stable = tc/limits.stepsPerCollision;
+
+        if (rate > 0.0)
+        {
+            stable = std::min(stable, limits.maxMovement/rate);
+        }
+
+        return stable;
+    }
+
+    void sPhysics::chooseTimeStep(EntityComponentSystem * m, sCollision * collisions)
+    {
+        stableDt = stableTimeStep(m, collisions);
+
+        unsigned cap = std::max(limits.maxSubSamples, 1u);
+
+        if (limits.budget > 0.0 && subStepCost > 0.0)
+        {
+            cap = std::min(cap, std::max(unsigned(limits.budget/subStepCost), 1u));
+        }
+
+        // stableDt may be infinite with nothing moving or colliding,
+        //  and round off must not add a sub step (e.g. tc/10 for 10 dt)
+        Real n = std::ceil(limits.frameTime/stableDt - Real(1e-4));
+        unsigned steps = n > Real(cap) ? cap : std::max(unsigned(n), 1u);
+
+        Real delta = limits.frameTime/Real(steps);
+
+        if (delta > stableDt*Real(1.0+1e-4))
+        {
+            delta = stableDt;
+        }
+
+        if (delta != dt)
+        {
+            rescaleTimeStep(m, delta/dt);
+            setTimeStep(delta);
+        }
+
+        subSamples = steps;
+    }
+
+    void sPhysics::rescaleTimeStep(EntityComponentSystem * m, Real ratio)
+    {
+        // Verlet keeps velocity as the last step's displacement
+        m->eachChunk<cPhysics, cTransform>
+        (
+            [ratio](size_t n, const Id *, cPhysics * dataP, cTransform * dataT)
+            {
+                for (size_t k = 0; k < n; k++)
+                {
+                    dataP[k].lastX = dataT[k].x - (dataT[k].x-dataP[k].lastX)*ratio;
+                    dataP[k].lastY = dataT[k].y - (dataT[k].y-dataP[k].lastY)*ratio;
+                    dataP[k].lastTheta = dataT[k].theta - (dataT[k].theta-dataP[k].lastTheta)*ratio;
+                }
+            }
+        );
+
+        m->eachChunk<cPhysics, cTransform, cCollideable>
+        (
+            [ratio](size_t n, const Id *, cPhysics *, cTransform *, cCollideable * data)
+            {
+                for (size_t k = 0; k < n; k++)
+                {
+                    data[k].mesh.rescaleTimeStep(ratio);
+                }
+            }
+        );
+    }
+
     void sPhysics::update(EntityComponentSystem * m, ThreadPool * workers)
     {
 
@@ -37,72 +177,178 @@ namespace Hop::System::Physics
                 This models an object moving within a fluid.
 
                 Soft bodies perform their own integration due to the nature of their movable mesh points.
+
+                Moveable rigid bodies take their translational step vectorised (RigidBodies),
+                gathered from their components into packed lanes and scattered back every step.
+
+                Sleeping bodies are skipped entirely.
         
         */
 
-        ComponentArray<cCollideable> & collideables = m->getComponentArray<cCollideable>();
-        ComponentArray<cPhysics> & physics = m->getComponentArray<cPhysics>();
-        ComponentArray<cTransform> & transforms = m->getComponentArray<cTransform>();
-
-        double nx, ny, ntheta, at, bt, ct, r, dx, dy, d, ar, br, cr;
+        std::array<uint64_t, 3> versions =
+        {
+            m->getComponentArray<cPhysics>().getVersion(),
+            m->getComponentArray<cTransform>().getVersion(),
+            m->getComponentArray<cCollideable>().getVersion()
+        };
 
-        energy = 0.0;
+        if (bodiesStale || bodiesOf != m || versions != bodyVersions)
+        {
+            gatherBodies(m);
 
-        bool rigid = false;
+            bodiesStale = false;
+            bodiesOf = m;
+            bodyVersions = versions;
+        }
 
-        for (auto it = objects.begin(); it != objects.end(); it++)
+        for (cPhysics * dataP : sleepers)
         {
-            r = 0.0;
-            cTransform & dataT = transforms.get(*it);
-            cPhysics & dataP = physics.get(*it);
+            dataP->fx = 0.0;
+            dataP->fy = 0.0;
+            dataP->tau = 0.0;
+        }
+
+        /*
+            Objects are independent here so chunks may run in any order
+            on any thread. Chunking is fixed by UPDATE_CHUNK_SIZE, not the
+            thread count, and partial energies are summed in chunk order,
+            so energy is the same whether threaded or not.
+        */
+
+        size_t chunks = (bodies.size()+UPDATE_CHUNK_SIZE-1)/UPDATE_CHUNK_SIZE;
+
+        chunkEnergy.assign(chunks, 0.0);
 
-            if (collideables.hasComponent(*it))
+        if (workers != nullptr && chunks > 1)
+        {
+            for (size_t c = 0; c < chunks; c++)
             {
-                cCollideable & data = collideables.get(*it);
-                rigid = data.mesh.getIsRigid();
+                workers->queueJob
+                (
+                    std::bind
+                    (
+                        &sPhysics::updateChunk,
+                        this,
+                        c
+                    )
+                );
             }
 
-            if (!dataP.isMoveable)
+            workers->wait();
+        }
+        else
+        {
+            for (size_t c = 0; c < chunks; c++)
             {
-                dataP.fx = 0.0;
-                dataP.fy = 0.0;
-                dataP.vx = 0.0;
-                dataP.vy = 0.0;
+                updateChunk(c);
             }
-            else if (rigid)
-            {
-                
-                ct = dataP.translationalDrag*dt/(2.0*dataP.mass);
-                bt = 1.0/(1.0+ct);
-                at = (1.0-ct)*bt;
+        }
+
+        energy = 0.0;
+
+        for (double e : chunkEnergy)
+        {
+            energy += e;
+        }
+    }
+
+    void sPhysics::gatherBodies(EntityComponentSystem * m)
+    {
+        ComponentArray<cCollideable> & collideables = m->getComponentArray<cCollideable>();
+
+        ComponentView<cPhysics, cTransform> & view = m->view<cPhysics, cTransform>();
+        const std::vector<uint64_t> & meshes = view.optional(collideables);
+
+        bodies.clear();
+        bodies.reserve(view.size());
+        sleepers.clear();
 
-                nx = 2.0*bt*dataT.x - at*dataP.lastX + bt*dataP.fx*dtdt/dataP.mass;
-                ny = 2.0*bt*dataT.y - at*dataP.lastY + bt*dataP.fy*dtdt/dataP.mass;
+        size_t row = 0;
+
+        view.each
+        (
+            [&](const Id & id, cPhysics & dataP, cTransform & dataT)
+            {
+                uint64_t mesh = meshes[row++];
 
-                if (r > 0)
+                if (dataP.isAsleep)
                 {
-                    dx = nx - dataT.x;
-                    dy = ny - dataT.y;
+                    sleepers.push_back(&dataP);
+                    return;
+                }
 
-                    d = std::sqrt(dx*dx+dy*dy);
+                Body body;
 
-                    if (d > r*movementLimitRadii)
-                    {
-                        nx = dataT.x + r*movementLimitRadii * dx / d;
-                        ny = dataT.y + r*movementLimitRadii * dy / d;
-                    }
+                body.id = id;
+                body.physics = &dataP;
+                body.transform = &dataT;
+                body.collideable = nullptr;
+                body.lane = NO_LANE;
+
+                if (mesh != ComponentView<cPhysics, cTransform>::NO_INDEX)
+                {
+                    body.collideable = &collideables.atIndex(mesh);
                 }
 
-                dataP.vx = (nx-dataP.lastX)/(dt*2.0);
-                dataP.vy = (ny-dataP.lastY)/(dt*2.0);
+                bodies.push_back(body);
+            }
+        );
+
+        rigidBodies.resize(bodies.size());
+    }
+
+    void sPhysics::updateChunk(size_t c)
+    {
+        size_t begin = c*UPDATE_CHUNK_SIZE;
+        size_t end = std::min(begin+UPDATE_CHUNK_SIZE, bodies.size());
 
-                energy += dataP.vx * dataP.vx + dataP.vy * dataP.vy;
+        /*
+            The chunk's moveable rigid bodies are [begin, lane) of
+            rigidBodies, checked each step since either may change
+            between steps. Chunks' ranges are disjoint.
+        */
 
-                dataP.lastX = dataT.x;
-                dataP.lastY = dataT.y;
+        size_t lane = begin;
 
-                dataP.fx = 0.0;
-                dataP.fy = 0.0;
+        for (size_t i = begin; i < end; i++)
+        {
+            Body & body = bodies[i];
+
+            bool rigid = body.collideable == nullptr || body.collideable->mesh.getIsRigid();
+
+            body.lane = NO_LANE;
+
+            if (body.physics->isMoveable && rigid)
+            {
+                body.lane = lane++;
+                rigidBodies.set(body.lane, body.transform, body.physics);
+            }
+            else if (!body.physics->isMoveable)
+            {
+                body.physics->fx = 0.0;
+                body.physics->fy = 0.0;
+                body.physics->vx = 0.0;
+                body.physics->vy = 0.0;
+            }
+        }
+
+        rigidBodies.integrate(dt, dtdt, begin, lane);
+
+        Real ntheta, ar, br, cr, v2;
+        double e = 0.0;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            Body & body = bodies[i];
+            cTransform & dataT = *body.transform;
+            cPhysics & dataP = *body.physics;
+
+            v2 = 0.0;
+
+            if (body.lane != NO_LANE)
+            {
+                v2 = dataP.vx*dataP.vx + dataP.vy*dataP.vy;
+                e += v2;
 
                 dataP.omega += dataP.tau;
 
@@ -115,26 +361,37 @@ namespace Hop::System::Physics
                 dataP.phi = (ntheta-dataP.lastTheta)/(2.0*dt);
 
                 dataP.lastTheta = dataT.theta;
-                
-                dataP.x = nx;
-                dataP.y = ny;
 
-                dataT.x = nx;
-                dataT.y = ny;
                 dataT.theta = ntheta;
-
             }
 
-            if (collideables.hasComponent(*it))
+            if (body.collideable != nullptr)
             {
-                cCollideable & data = collideables.get(*it);
+                cCollideable & data = *body.collideable;
                 data.updateMesh(
                     dataT,
                     dataP,
-                    dt
+                    dt,
+                    softBodySubCycles
                 );
                 dataP.momentOfInertia = data.mesh.momentOfInertia(dataT.x, dataT.y, dataP.mass);
-                energy += data.mesh.energy();
+                e += data.mesh.energy();
+            }
+
+            if (sleeping)
+            {
+                if 
+                (
+                    body.lane != NO_LANE && 
+                    0.5*(v2+dataP.phi*dataP.phi*dataP.momentOfInertia/dataP.mass) < sleepEnergy
+                )
+                {
+                    dataP.restingSteps++;
+                }
+                else
+                {
+                    dataP.restingSteps = 0;
+                }
             }
 
             dataP.fx = 0.0;
@@ -142,6 +399,8 @@ namespace Hop::System::Physics
             dataP.tau = 0.0;
             dataP.omega = 0.0;
         }
+
+        chunkEnergy[c] = e;
     }
 
     void sPhysics::gravityForce
@@ -150,36 +409,216 @@ namespace Hop::System::Physics
     )
     {
 
-        double fx = ngx*gravity; double fy = ngy*gravity;
+        Real fx = ngx*gravity; Real fy = ngy*gravity;
 
         ComponentArray<cCollideable> & collideables = m->getComponentArray<cCollideable>();
 
-        for (auto it = objects.begin(); it != objects.end(); it++)
-        {
+        ComponentView<cPhysics, cTransform> & view = m->view<cPhysics, cTransform>();
+        const std::vector<uint64_t> & meshes = view.optional(collideables);
 
-            if (collideables.hasComponent(*it))
+        size_t row = 0;
+
+        view.each
+        (
+            [&](const Id &, cPhysics & dataP, cTransform &)
             {
-                cCollideable & data = collideables.get(*it);
-                if (!data.mesh.getIsRigid())
-                {   
-                    data.mesh.applyForce(fx, fy, true);
-                    continue;
+                uint64_t mesh = meshes[row++];
+
+                if (mesh != ComponentView<cPhysics, cTransform>::NO_INDEX)
+                {
+                    cCollideable & data = collideables.atIndex(mesh);
+                    if (!data.mesh.getIsRigid())
+                    {   
+                        data.mesh.applyForce(fx, fy, true);
+                        return;
+                    }
                 }
-            }
-            cPhysics & dataP = m->getComponent<cPhysics>(it->id);
 
-            dataP.fx += fx;
-            dataP.fy += fy;
+                if (dataP.isAsleep)
+                {
+                    return;
+                }
+
+                dataP.fx += fx;
+                dataP.fy += fy;
             
+            }
+        );
+
+    }
+
+    void sPhysics::wake(EntityComponentSystem * m, const Id & i)
+    {
+        ComponentArray<cPhysics> & physics = m->getComponentArray<cPhysics>();
+
+        if (!physics.hasComponent(i))
+        {
+            return;
+        }
+
+        cPhysics & dataP = physics.get(i);
+
+        dataP.restingSteps = 0;
+
+        if (!dataP.isAsleep)
+        {
+            return;
+        }
+
+        uint64_t island = dataP.island;
+
+        for (const Id & j : islands[island])
+        {
+            if (physics.hasComponent(j))
+            {
+                cPhysics & p = physics.get(j);
+                p.isAsleep = false;
+                p.restingSteps = 0;
+            }
+        }
+
+        islands[island].clear();
+        freeIslands.push_back(island);
+
+        bodiesStale = true;
+    }
+
+    void sPhysics::wakeOnContact(EntityComponentSystem * m, sCollision * collisions)
+    {
+        ComponentArray<cPhysics> & physics = m->getComponentArray<cPhysics>();
+
+        for (const auto & c : collisions->getCollisions())
+        {
+            if (c.second.world)
+            {
+                continue;
+            }
+
+            cPhysics & a = physics.get(c.first);
+            cPhysics & b = physics.get(c.second.with);
+
+            // pairs are recorded both ways round
+            if (a.isAsleep && !b.isAsleep && b.isMoveable && b.restingSteps == 0)
+            {
+                wake(m, c.first);
+            }
+        }
+    }
+
+    void sPhysics::sleepIslands(sCollision * collisions)
+    {
+        /*
+            Islands are the connected components of the contact 
+            graph between awake moveable bodies. An island sleeps
+            when every body in it is a rigid body which has rested
+            for sleepSteps steps.
+        */
+
+        bodyIndex.clear();
+        parent.resize(bodies.size());
+        canSleep.assign(bodies.size(), true);
+
+        for (size_t i = 0; i < bodies.size(); i++)
+        {
+            bodyIndex[bodies[i].id] = i;
+            parent[i] = i;
         }
 
+        for (const auto & c : collisions->getCollisions())
+        {
+            if (c.second.world)
+            {
+                continue;
+            }
+
+            auto a = bodyIndex.find(c.first);
+            auto b = bodyIndex.find(c.second.with);
+
+            if (a == bodyIndex.end() || b == bodyIndex.end())
+            {
+                continue;
+            }
+
+            if (!bodies[a->second].physics->isMoveable || !bodies[b->second].physics->isMoveable)
+            {
+                continue;
+            }
+
+            parent[root(a->second)] = root(b->second);
+        }
+
+        for (size_t i = 0; i < bodies.size(); i++)
+        {
+            const Body & body = bodies[i];
+
+            if (!body.physics->isMoveable)
+            {
+                continue;
+            }
+
+            if (body.lane == NO_LANE || body.physics->restingSteps < sleepSteps)
+            {
+                canSleep[root(i)] = false;
+            }
+        }
+
+        std::unordered_map<size_t, uint64_t> newIslands;
+
+        for (size_t i = 0; i < bodies.size(); i++)
+        {
+            const Body & body = bodies[i];
+            size_t r = root(i);
+
+            if (!body.physics->isMoveable || !canSleep[r])
+            {
+                continue;
+            }
+
+            auto it = newIslands.find(r);
+
+            if (it == newIslands.end())
+            {
+                uint64_t island;
+
+                if (freeIslands.empty())
+                {
+                    island = islands.size();
+                    islands.push_back({});
+                }
+                else
+                {
+                    island = freeIslands.back();
+                    freeIslands.pop_back();
+                }
+
+                it = newIslands.insert(std::pair(r, island)).first;
+            }
+
+            cPhysics & dataP = *body.physics;
+            cTransform & dataT = *body.transform;
+
+            dataP.isAsleep = true;
+            dataP.island = it->second;
+
+            dataP.vx = 0.0;
+            dataP.vy = 0.0;
+            dataP.phi = 0.0;
+
+            dataP.lastX = dataT.x;
+            dataP.lastY = dataT.y;
+            dataP.lastTheta = dataT.theta;
+
+            islands[it->second].push_back(body.id);
+
+            bodiesStale = true;
+        }
     }
 
     void sPhysics::applyForce(
         EntityComponentSystem * m,
         Id & i,
-        double fx,
-        double fy,
+        Real fx,
+        Real fy,
         bool global
     )
     {
@@ -187,6 +626,8 @@ namespace Hop::System::Physics
         cPhysics & dataP = m->getComponent<cPhysics>(i);
         ComponentArray<cCollideable> & collideables = m->getComponentArray<cCollideable>();
 
+        wake(m, i);
+
         if (collideables.hasComponent(i))
         {
             cCollideable & data = collideables.get(i);
@@ -211,11 +652,13 @@ namespace Hop::System::Physics
     void sPhysics::applyTorque(
         EntityComponentSystem * m,
         Id & i,
-        double tau
+        Real tau
     )
     {
         cPhysics & dataP = m->getComponent<cPhysics>(i);
 
+        wake(m, i);
+
         if (m->hasComponent<cCollideable>(i))
         {
             cCollideable & c = m->getComponent<cCollideable>(i);
@@ -238,47 +681,59 @@ namespace Hop::System::Physics
 
     void sPhysics::applyForce(
         EntityComponentSystem * m,
-        double fx,
-        double fy,
+        Real fx,
+        Real fy,
         bool global
     )
     {
 
         ComponentArray<cCollideable> & collideables = m->getComponentArray<cCollideable>();
 
-        for (auto it = objects.begin(); it != objects.end(); it++)
-        {
+        ComponentView<cPhysics, cTransform> & view = m->view<cPhysics, cTransform>();
+        const std::vector<uint64_t> & meshes = view.optional(collideables);
+
+        size_t row = 0;
 
-            if (collideables.hasComponent(*it))
+        view.each
+        (
+            [&](const Id & id, cPhysics & dataP, cTransform &)
             {
-                cCollideable & data = collideables.get(*it);
-                if (!data.mesh.getIsRigid())
-                {   
-                    data.mesh.applyForce(fx, fy, global);
-                    continue;
-                }
-            }
+                uint64_t mesh = meshes[row++];
 
-            cPhysics & dataP = m->getComponent<cPhysics>(*it);
+                wake(m, id);
 
-            dataP.fx += fx;
-            dataP.fy += fy;
-        }
+                if (mesh != ComponentView<cPhysics, cTransform>::NO_INDEX)
+                {
+                    cCollideable & data = collideables.atIndex(mesh);
+                    if (!data.mesh.getIsRigid())
+                    {   
+                        data.mesh.applyForce(fx, fy, global);
+                        return;
+                    }
+                }
+
+                dataP.fx += fx;
+                dataP.fy += fy;
+            }
+        );
     }
 
     void sPhysics::stabaliseObjectParameters(EntityComponentSystem * m)
     {
-        for (auto it = objects.begin(); it != objects.end(); it++)
-        {
-            cTransform & dataT = m->getComponent<cTransform>(*it);
-            cPhysics & dataP = m->getComponent<cPhysics>(*it);
-
-            dataP.translationalDrag = 1.1*stableDragUnderdampedLangevinWithGravityUnitMass(
-                dt,
-                gravity,
-                dataT.scale
-            );
-        }
+        m->eachChunk<cPhysics, cTransform>
+        (
+            [this](size_t n, const Id *, cPhysics * dataP, cTransform * dataT)
+            {
+                for (size_t k = 0; k < n; k++)
+                {
+                    dataP[k].translationalDrag = 1.1*stableDragUnderdampedLangevinWithGravityUnitMass(
+                        dt,
+                        gravity,
+                        dataT[k].scale
+                    );
+                }
+            }
+        );
     }
 
     /*
@@ -310,10 +765,10 @@ namespace Hop::System::Physics
         drag ~ dt*gravity/r.
 
     */
-    double sPhysics::stableDragUnderdampedLangevinWithGravityUnitMass(
-        double dt,
-        double gravity,
-        double radius
+    Real sPhysics::stableDragUnderdampedLangevinWithGravityUnitMass(
+        Real dt,
+        Real gravity,
+        Real radius
     )
     {
         return (dt*1.05)*gravity/radius;
@@ -1,6 +1,7 @@
 #include <World/marchingWorld.h>
 
 #ifndef ANDROID
+  #include <iostream>
 #else
   #include <android/log.h>
 #endif
@@ -37,23 +38,8 @@ namespace Hop::World
 
         processBufferToOffsets();
 
-        glBindBuffer(GL_ARRAY_BUFFER,VBOid);
-        glBufferSubData(
-            GL_ARRAY_BUFFER,
-            0,
-            sizeof(float)*RENDER_REGION_SIZE*RENDER_REGION_SIZE,
-            renderIds.get()
-        );
-
-        glBindBuffer(GL_ARRAY_BUFFER,VBOoffset);
-        glBufferSubData(
-            GL_ARRAY_BUFFER,
-            0,
-            sizeof(float)*3*RENDER_REGION_SIZE*RENDER_REGION_SIZE,
-            renderOffsets.get()
-        );
-
-        glBindBuffer(GL_ARRAY_BUFFER,0);
+        uploadRenderIds();
+        uploadRenderOffsets();
     }
 
     bool MarchingWorld::updateRegion(float x, float y)
@@ -108,20 +94,11 @@ namespace Hop::World
         
         processBufferToOffsets();
 
-        glBindBuffer(GL_ARRAY_BUFFER,VBOid);
-        glBufferSubData(
-            GL_ARRAY_BUFFER,
-            0,
-            sizeof(float)*RENDER_REGION_SIZE*RENDER_REGION_SIZE,
-            renderIds.get()
-        );
-
-        glBindBuffer(GL_ARRAY_BUFFER,0);
+        uploadRenderIds();
 
         tilePosX = ix; tilePosY = iy;
         
-        std::pair<float,float> p = getPos();
-        camera->setPosition(p.first,p.second);
+        followRegion();
 
         return true;
     }
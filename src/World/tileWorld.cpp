@@ -31,18 +31,131 @@ namespace Hop::World
             }
         }
 
-        glBindBuffer(GL_ARRAY_BUFFER,VBOoffset);
-        glBufferSubData(
-            GL_ARRAY_BUFFER,
-            0,
-            sizeof(float)*3*RENDER_REGION_SIZE*RENDER_REGION_SIZE,
-            renderOffsets.get()
-        );
+        uploadRenderOffsets();
 
-        glBindBuffer(GL_ARRAY_BUFFER,0);
+        cacheRegion();
 
     }
 
+    void TileWorld::load(std::string fileNameWithoutExtension, bool compressed)
+    {
+        AbstractWorld::load(fileNameWithoutExtension, compressed);
+        cacheRegion();
+    }
+
+    void TileWorld::setTile(int i, int j, uint64_t id)
+    {
+        map->setAtCoordinate(i,j,id);
+
+        if (inRegionRing(i,j))
+        {
+            regionTiles[regionRingIndex(i,j)] = toTile<uint64_t>(id);
+        }
+
+        // a tile's segments depend on its 4 neighbours
+        for (int u = i-1; u <= i+1; u++)
+        {
+            for (int v = j-1; v <= j+1; v++)
+            {
+                if (inRegion(u,v))
+                {
+                    size_t k = regionIndex(u,v);
+                    regionSegmentCount[k] = buildSegments(u,v,&regionSegments[k*4]);
+                }
+            }
+        }
+
+        forceUpdate = true;
+    }
+
+    void TileWorld::cacheRegion()
+    {
+        const int n = int(RENDER_REGION_SIZE);
+
+        regionTiles.resize((n+2)*(n+2));
+
+        for (int i = -1; i <= n; i++)
+        {
+            for (int j = -1; j <= n; j++)
+            {
+                regionTiles[regionRingIndex(i,j)] = toTile<uint64_t>(map->getAtCoordinate(i,j));
+            }
+        }
+
+        regionSegments.resize(n*n*4);
+        regionSegmentCount.resize(n*n);
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                size_t k = regionIndex(i,j);
+                regionSegmentCount[k] = buildSegments(i,j,&regionSegments[k*4]);
+            }
+        }
+    }
+
+    uint8_t TileWorld::buildSegments(int i, int j, TileSegment * segments)
+    {
+        // as worldToTileData, tileToIdCoord is the identity
+        double s = 1.0/float(RENDER_REGION_SIZE);
+        double x0 = i*s;
+        double y0 = j*s;
+
+        TileBoundsData b;
+
+        // centred on the tile every side is within range
+        westBounds(x0,y0,s*2.0,b,x0,y0,s,i,j);
+        northBounds(x0,y0,s*2.0,b,x0,y0,s,i,j);
+        eastBounds(x0,y0,s*2.0,b,x0,y0,s,i,j);
+        southBounds(x0,y0,s*2.0,b,x0,y0,s,i,j);
+
+        uint8_t n = 0;
+
+        // unset (and zero coordinate) segments are not collided with
+
+        if (b.wx0 != 0 && b.wx1 != 0 && b.wy0 != 0 && b.wy1 != 0)
+        {
+            segments[n++] = TileSegment {TileSide::WEST, x0, b.wx0, b.wy0, b.wx1, b.wy1};
+        }
+
+        if (b.nx0 != 0 && b.nx1 != 0 && b.ny0 != 0 && b.ny1 != 0)
+        {
+            segments[n++] = TileSegment {TileSide::NORTH, y0+s, b.nx0, b.ny0, b.nx1, b.ny1};
+        }
+
+        if (b.ex0 != 0 && b.ex1 != 0 && b.ey0 != 0 && b.ey1 != 0)
+        {
+            segments[n++] = TileSegment {TileSide::EAST, x0+s, b.ex0, b.ey0, b.ex1, b.ey1};
+        }
+
+        if (b.sx0 != 0 && b.sx1 != 0 && b.sy0 != 0 && b.sy1 != 0)
+        {
+            segments[n++] = TileSegment {TileSide::SOUTH, y0, b.sx0, b.sy0, b.sx1, b.sy1};
+        }
+
+        return n;
+    }
+
+    const TileSegment * TileWorld::tileSegments
+    (
+        int i, 
+        int j, 
+        uint8_t & count, 
+        TileSegment * scratch
+    )
+    {
+        if (inRegion(i,j))
+        {
+            size_t k = regionIndex(i,j);
+            count = regionSegmentCount[k];
+            return &regionSegments[k*4];
+        }
+
+        count = buildSegments(i,j,scratch);
+        return scratch;
+    }
+
     void TileWorld::tileToIdCoord(int ix, int iy, int & i, int & j)
     {
         i = ix;
@@ -62,7 +175,7 @@ namespace Hop::World
         worldToTile(x,y,ix,iy);
         tileToIdCoord(ix,iy,i,j);
 
-        h = toTile<uint64_t>(map->getAtCoordinate(i,j));
+        h = tileType(i,j);
 
 
         s = 1.0/float(RENDER_REGION_SIZE);
@@ -480,6 +593,11 @@ namespace Hop::World
     Tile TileWorld::tileType(int i, int j)
     {
 
+        if (inRegionRing(i,j))
+        {
+            return regionTiles[regionRingIndex(i,j)];
+        }
+
         return toTile<uint64_t>(map->getAtCoordinate(i,j));
 
     }
@@ -517,20 +635,13 @@ namespace Hop::World
             }
         }
 
-        glBindBuffer(GL_ARRAY_BUFFER,VBOid);
-        glBufferSubData(
-            GL_ARRAY_BUFFER,
-            0,
-            sizeof(float)*RENDER_REGION_SIZE*RENDER_REGION_SIZE,
-            renderIds.get()
-        );
+        uploadRenderIds();
 
-        glBindBuffer(GL_ARRAY_BUFFER,0);
+        cacheRegion();
 
         tilePosX = ix; tilePosY = iy;
         
-        std::pair<float,float> p = getPos();
-        camera->setPosition(p.first,p.second);
+        followRegion();
 
         return true;
     }
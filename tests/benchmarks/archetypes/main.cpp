@@ -0,0 +1,148 @@
+#include "main.h"
+
+/*
+    Per object cost of a cTransform and cPhysics pass, with
+    component array storage walked by view<T...>().each, and with
+    archetype storage walked by eachChunk.
+
+        BenchmarkArchetypes [repeats] [objects ...]
+
+    Every other object also has a cRenderable. A random quarter
+    then has its cPhysics removed and added back (churn), so in
+    component array storage the cPhysics array is no longer in the
+    cTransform array's order. Reported are the churn (the moves
+    between archetypes), the first pass after it (in archetype
+    storage, putting the arrays back in order) and the steady
+    state pass, in ns per object.
+*/
+
+struct Timing
+{
+    double churn;
+    double first;
+    double pass;
+    double sum;
+};
+
+Real touch(cTransform & t, cPhysics & p)
+{
+    p.lastX = t.x - p.vx;
+    p.lastY = t.y - p.vy;
+    return p.lastX+p.lastY;
+}
+
+Real pass(EntityComponentSystem & manager)
+{
+    Real sum = 0.0;
+
+    if (manager.getStorage() == Storage::ARCHETYPES)
+    {
+        manager.eachChunk<cTransform, cPhysics>
+        (
+            [&sum](size_t n, const Id *, cTransform * t, cPhysics * p)
+            {
+                for (size_t k = 0; k < n; k++)
+                {
+                    sum += touch(t[k], p[k]);
+                }
+            }
+        );
+    }
+    else
+    {
+        manager.view<cTransform, cPhysics>().each
+        (
+            [&sum](const Id &, cTransform & t, cPhysics & p)
+            {
+                sum += touch(t, p);
+            }
+        );
+    }
+
+    return sum;
+}
+
+Timing run(unsigned n, unsigned repeats, Storage storage)
+{
+    EntityComponentSystem manager(&identityCallback, MAX_OBJECTS, storage);
+
+    std::vector<Id> ids;
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        Id id = manager.createObject();
+
+        manager.addComponent<cTransform>(id, cTransform(Real(i), 0.0, 0.0, 1.0));
+        manager.addComponent<cPhysics>(id, cPhysics(Real(i), 0.0, 0.0));
+
+        if (i % 2 == 0)
+        {
+            manager.addComponent<cRenderable>(id, cRenderable("circleShader"));
+        }
+
+        ids.push_back(id);
+    }
+
+    // once to build views and arrange arrays
+    pass(manager);
+
+    std::default_random_engine e(31415926);
+    std::shuffle(ids.begin(), ids.end(), e);
+    ids.resize(n/4);
+
+    Timing t;
+
+    TimePoint t0 = now();
+
+    for (const Id & id : ids)
+    {
+        cPhysics p = manager.getComponent<cPhysics>(id);
+        manager.removeComponent<cPhysics>(id);
+        manager.addComponent<cPhysics>(id, p);
+    }
+
+    TimePoint t1 = now();
+
+    t.sum = pass(manager);
+
+    TimePoint t2 = now();
+
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        t.sum += pass(manager);
+    }
+
+    TimePoint t3 = now();
+
+    t.churn = nsPer(t0, t1, ids.size());
+    t.first = nsPer(t1, t2, n);
+    t.pass = nsPer(t2, t3, double(n)*repeats);
+
+    return t;
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned repeats = 100;
+    std::vector<unsigned> objects = {1000, 10000, 100000};
+
+    parseArguments(argc, argv, repeats, objects);
+
+    std::cout << "objects, storage, churn (ns/move), first pass (ns/object), pass (ns/object)\n";
+
+    for (unsigned n : objects)
+    {
+        Timing arrays = run(n, repeats, Storage::COMPONENT_ARRAYS);
+        Timing archetypes = run(n, repeats, Storage::ARCHETYPES);
+
+        if (arrays.sum != archetypes.sum)
+        {
+            std::cout << "passes differ, " << arrays.sum << " and " << archetypes.sum << "\n";
+        }
+
+        row(n, "component arrays", arrays.churn, arrays.first, arrays.pass);
+        row(n, "archetypes", archetypes.churn, archetypes.first, archetypes.pass);
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <random>
+#include <algorithm>
+
+#include "../benchmark.h"
+
+#include <Object/entityComponentSystem.h>
+
+using Hop::Real;
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Storage;
+using Hop::Object::MAX_OBJECTS;
+using Hop::Object::identityCallback;
+using Hop::Object::Id;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::Object::Component::cRenderable;
+
+#endif /* MAIN_H */
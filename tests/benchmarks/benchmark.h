@@ -0,0 +1,86 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace std::chrono;
+
+/*
+    Arguments, timing and CSV output shared by the benchmarks
+    run as
+
+        Benchmark [repeats] [sizes ...]
+*/
+
+typedef high_resolution_clock::time_point TimePoint;
+
+inline TimePoint now() { return high_resolution_clock::now(); }
+
+// seconds from t0 to t1
+inline double elapsed(TimePoint t0, TimePoint t1)
+{
+    return duration_cast<duration<double>>(t1-t0).count();
+}
+
+// nanoseconds from t0 to t1 for each of n
+inline double nsPer(TimePoint t0, TimePoint t1, double n)
+{
+    return elapsed(t0, t1)*1e9/n;
+}
+
+// repeats keeps its default unless given, the rest as given
+inline void parseArguments
+(
+    int argc,
+    char ** argv,
+    unsigned & repeats,
+    std::vector<std::string> & rest
+)
+{
+    if (argc > 1)
+    {
+        repeats = std::stoi(argv[1]);
+    }
+
+    for (int i = 2; i < argc; i++)
+    {
+        rest.push_back(argv[i]);
+    }
+}
+
+// repeats and sizes keep their defaults unless given
+inline void parseArguments
+(
+    int argc,
+    char ** argv,
+    unsigned & repeats,
+    std::vector<unsigned> & sizes
+)
+{
+    std::vector<std::string> rest;
+    parseArguments(argc, argv, repeats, rest);
+
+    if (!rest.empty())
+    {
+        sizes.clear();
+        for (const std::string & a : rest)
+        {
+            sizes.push_back(std::stoi(a));
+        }
+    }
+}
+
+// a line of comma separated values, to 4 significant figures
+template <class T, class ... U>
+void row(const T & first, const U & ... rest)
+{
+    std::cout << std::setprecision(4) << first;
+    ((std::cout << ", " << rest), ...);
+    std::cout << "\n";
+}
+
+#endif /* BENCHMARK_H */
@@ -0,0 +1,298 @@
+#include "main.h"
+
+/*
+    The fixed capacity cell list CellList used before the
+    counting sort build, 64 slots per cell and 100000 in total,
+    with primitives past either cap silently dropped.
+*/
+class FixedCellList
+{
+
+public:
+
+    static const uint64_t MAX_PARTICLES = 100000;
+    static const uint64_t MAX_PARTICLES_PER_CELL = 64;
+    static const uint64_t NULL_INDEX = MAX_PARTICLES+1;
+
+    FixedCellList(uint64_t n)
+    : rootNCells(n), nCells(n*n), dx(1.0/double(n)), dy(1.0/double(n))
+    {
+        cells = std::make_unique<uint64_t[]>(nCells*MAX_PARTICLES_PER_CELL);
+        lastElementInCell = std::make_unique<uint64_t[]>(nCells);
+        id = std::make_unique<std::pair<Id,uint64_t>[]>(MAX_PARTICLES);
+        notEmpty = std::make_unique<bool[]>(nCells);
+
+        lastElement = NULL_INDEX;
+        for (unsigned i = 0; i < nCells; i++)
+        {
+            notEmpty[i] = false;
+            for (unsigned j = 0; j < MAX_PARTICLES_PER_CELL; j++)
+            {
+                cells[i*MAX_PARTICLES_PER_CELL+j] = NULL_INDEX;
+            }
+
+            lastElementInCell[i] = NULL_INDEX;
+        }
+        for (unsigned i = 0; i < MAX_PARTICLES; i++)
+        {
+            id[i] = std::pair(Hop::Object::NULL_ID,NULL_INDEX);
+        }
+    }
+
+    uint64_t size() const { return lastElement == NULL_INDEX ? 0 : lastElement+1; }
+
+    void populate
+    (
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        const std::vector<Id> & objects
+    )
+    {
+        clear();
+
+        for (auto it = objects.begin(); it != objects.end(); it++)
+        {
+            cCollideable & data = dataC.get(*it);
+
+            for (unsigned i = 0; i < data.mesh.size(); i++)
+            {
+                const CollisionPrimitive & p = data.mesh[i];
+
+                uint64_t h = hash(p.x,p.y);
+
+                if (h < nCells && lastElementInCell[h] != MAX_PARTICLES_PER_CELL-1)
+                {
+                    if (lastElement != NULL_INDEX && lastElement+1 >= MAX_PARTICLES)
+                    {
+                        continue;
+                    }
+
+                    uint64_t next = lastElementInCell[h] == NULL_INDEX ? 0 : lastElementInCell[h]+1;
+                    uint64_t nextId = lastElement == NULL_INDEX ? 0 : lastElement+1;
+
+                    cells[h*MAX_PARTICLES_PER_CELL+next] = nextId;
+                    id[nextId] = std::pair(*it,i);
+
+                    lastElement = nextId;
+                    lastElementInCell[h] = next;
+                    notEmpty[h] = true;
+                }
+            }
+        }
+    }
+
+    void handleObjectObjectCollisions
+    (
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        CollisionResolver * resolver,
+        const std::vector<Id> & objects
+    )
+    {
+        collided.clear();
+        populate(dataC, dataP, objects);
+
+        for (uint64_t a = 0; a < rootNCells; a++)
+        {
+            for (uint64_t b = 0; b < rootNCells; b++)
+            {
+                cellCollisions(a,b,a,b,dataC,dataP,resolver);
+                cellCollisions(a,b,a+1,b+1,dataC,dataP,resolver);
+                cellCollisions(a,b,a,b+1,dataC,dataP,resolver);
+                cellCollisions(a,b,a+1,b,dataC,dataP,resolver);
+                cellCollisions(a,b,a+1,b-1,dataC,dataP,resolver);
+            }
+        }
+    }
+
+private:
+
+    uint64_t rootNCells, nCells;
+    double dx, dy;
+
+    std::unique_ptr<uint64_t[]> cells;
+    std::unique_ptr<uint64_t[]> lastElementInCell;
+    std::unique_ptr<bool[]> notEmpty;
+    std::unique_ptr<std::pair<Id,uint64_t>[]> id;
+    uint64_t lastElement;
+
+    std::multimap<Id, CollisionDetector::CollisionType> collided;
+
+    uint64_t hash(double x, double y)
+    {
+        return std::floor(x/dx)*rootNCells+std::floor(y/dy);
+    }
+
+    void clear()
+    {
+        for (uint64_t l = 0; l < nCells; l++)
+        {
+            notEmpty[l] = false;
+
+            uint64_t last = lastElementInCell[l] == NULL_INDEX ? 0 : lastElementInCell[l]+1;
+
+            for (uint64_t i = 0; i < last; i++)
+            {
+                cells[l*MAX_PARTICLES_PER_CELL+i] = NULL_INDEX;
+            }
+
+            lastElementInCell[l] = NULL_INDEX;
+        }
+
+        for (uint64_t i = 0; i < size(); i++)
+        {
+            id[i] = std::pair(Hop::Object::NULL_ID,NULL_INDEX);
+        }
+
+        lastElement = NULL_INDEX;
+    }
+
+    void cellCollisions
+    (
+        uint64_t a1,
+        uint64_t b1,
+        uint64_t a2,
+        uint64_t b2,
+        ComponentArray<cCollideable> & dataC,
+        ComponentArray<cPhysics> & dataP,
+        CollisionResolver * resolver
+    )
+    {
+        if (a1 >= rootNCells || b1 >= rootNCells || a2 >= rootNCells || b2 >= rootNCells)
+        {
+            return;
+        }
+
+        if (!notEmpty[a1*rootNCells+b1] || !notEmpty[a2*rootNCells+b2])
+        {
+            return;
+        }
+
+        uint64_t c1 = (a1*rootNCells+b1)*MAX_PARTICLES_PER_CELL;
+        uint64_t c2 = (a2*rootNCells+b2)*MAX_PARTICLES_PER_CELL;
+
+        // the length of each cell is found by scanning for NULL_INDEX
+        uint64_t n1 = 0;
+        uint64_t n2 = 0;
+
+        while (n1 < MAX_PARTICLES_PER_CELL && cells[c1+n1] != NULL_INDEX) { n1++; }
+        while (n2 < MAX_PARTICLES_PER_CELL && cells[c2+n2] != NULL_INDEX) { n2++; }
+
+        for (uint64_t p1 = 0; p1 < n1; p1++)
+        {
+            auto idi = id[cells[c1+p1]];
+            cCollideable & collidableI = dataC.get(idi.first);
+            cPhysics & physicsI = dataP.get(idi.first);
+
+            for (uint64_t p2 = 0; p2 < n2; p2++)
+            {
+                auto idj = id[cells[c2+p2]];
+
+                bool c = resolver->handleObjectObjectCollision
+                (
+                    idi.first,idi.second,
+                    idj.first,idj.second,
+                    collidableI, dataC.get(idj.first),
+                    physicsI, dataP.get(idj.first)
+                );
+
+                if (c)
+                {
+                    collided.insert(std::pair(idi.first,CollisionDetector::CollisionType(idj.first,false)));
+                    collided.insert(std::pair(idj.first,CollisionDetector::CollisionType(idi.first,false)));
+                }
+            }
+        }
+    }
+
+};
+
+/*
+    Rigid rods of MESH_SIZE circles, one cell long, at uniform
+    random positions in the unit square.
+*/
+void populate(EntityComponentSystem & manager, unsigned n, double cellLength)
+{
+    std::default_random_engine e(31415);
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+
+    std::vector<CollisionPrimitive> rod;
+    for (unsigned i = 0; i < MESH_SIZE; i++)
+    {
+        rod.push_back(CollisionPrimitive((i+0.5)/MESH_SIZE-0.5, 0.0, 0.5/MESH_SIZE));
+    }
+
+    for (unsigned i = 0; i < n/MESH_SIZE; i++)
+    {
+        Id id = manager.createObject();
+
+        double x = cellLength+U(e)*(1.0-2.0*cellLength);
+        double y = cellLength+U(e)*(1.0-2.0*cellLength);
+        double theta = 2.0*3.14159*U(e);
+
+        manager.addComponent<cTransform>(id, cTransform(x, y, theta, cellLength));
+        manager.addComponent<cPhysics>(id, cPhysics(x, y, theta));
+        manager.addComponent<cCollideable>(id, cCollideable(rod, x, y, theta, cellLength));
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned steps = 10;
+    std::vector<unsigned> sizes = {10000, 100000, 1000000};
+
+    parseArguments(argc, argv, steps, sizes);
+
+    SpringDashpot resolver(dt*10.0, 0.5, 0.0);
+
+    std::cout << "primitives, cells, "
+              << "fixed binned, fixed build (s), fixed query (s), "
+              << "csr binned, csr build (s), csr query (s)\n";
+
+    for (unsigned n : sizes)
+    {
+        EntityComponentSystem manager;
+
+        uint64_t rootNCells = std::max(1.0, std::floor(std::sqrt(n/DENSITY)));
+        double cellLength = 1.0/double(rootNCells);
+
+        populate(manager, n, cellLength);
+
+        ComponentArray<cCollideable> & dataC = manager.getComponentArray<cCollideable>();
+        ComponentArray<cPhysics> & dataP = manager.getComponentArray<cPhysics>();
+        CollideableView & objects = manager.view<cPhysics, cCollideable>();
+
+        FixedCellList fixed(rootNCells);
+        CellList csr(rootNCells);
+        CollisionDetector & detector = csr;
+
+        // build alone, then build and query, the difference is the query
+
+        TimePoint t0 = now();
+
+        for (unsigned s = 0; s < steps; s++) { fixed.populate(dataC, dataP, objects.getIds()); }
+
+        TimePoint t1 = now();
+
+        for (unsigned s = 0; s < steps; s++) { fixed.handleObjectObjectCollisions(dataC, dataP, &resolver, objects.getIds()); }
+
+        TimePoint t2 = now();
+
+        for (unsigned s = 0; s < steps; s++) { csr.populate(dataC, dataP, objects); }
+
+        TimePoint t3 = now();
+
+        for (unsigned s = 0; s < steps; s++) { detector.handleObjectObjectCollisions(dataC, dataP, &resolver, objects); }
+
+        TimePoint t4 = now();
+
+        double fixedBuild = elapsed(t0, t1)/steps;
+        double fixedQuery = elapsed(t1, t2)/steps-fixedBuild;
+        double csrBuild = elapsed(t2, t3)/steps;
+        double csrQuery = elapsed(t3, t4)/steps-csrBuild;
+
+        row(n, rootNCells*rootNCells, fixed.size(), fixedBuild, fixedQuery, csr.size(), csrBuild, csrQuery);
+    }
+
+    return 0;
+}
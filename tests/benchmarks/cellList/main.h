@@ -0,0 +1,39 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <random>
+#include <set>
+#include <map>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+#include "../benchmark.h"
+
+#include <Object/entityComponentSystem.h>
+#include <Collision/cellList.h>
+#include <Collision/springDashpotResolver.h>
+
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Id;
+using Hop::Object::Component::ComponentArray;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::Object::Component::cCollideable;
+using Hop::System::Physics::sPhysics;
+using Hop::System::Physics::CellList;
+using Hop::System::Physics::CollisionDetector;
+using Hop::System::Physics::CollideableView;
+using Hop::System::Physics::CollisionPrimitive;
+using Hop::System::Physics::CollisionResolver;
+using Hop::System::Physics::SpringDashpot;
+
+const double dt = 1.0/900.0;
+
+// primitives per object, objects are capped by the ECS
+const unsigned MESH_SIZE = 10;
+
+// mean primitives per cell
+const double DENSITY = 8.0;
+
+#endif /* MAIN_H */
@@ -0,0 +1,177 @@
+#include "main.h"
+
+/*
+    Per call cost of the EntityComponentSystem's component
+    lookups by type, before and after compile time type ids.
+
+        BenchmarkComponentLookup [repeats] [objects ...]
+
+    Before, every call hashed typeid(T).name() into unordered
+    maps of component ids and arrays, then cast a shared_ptr, and
+    hasComponent probed an unordered_map of signatures by Id, as
+    PreviousLookup does over the same arrays. The loops are those
+    of sPhysics::gravityForce and applyForce before dense views,
+    a hasComponent and getComponent per object, in ns per object.
+*/
+class PreviousLookup
+{
+
+public:
+
+    PreviousLookup(EntityComponentSystem & m, const std::vector<Id> & ids)
+    {
+        add<cTransform>(m, 0);
+        add<cPhysics>(m, 1);
+        add<cCollideable>(m, 2);
+
+        for (const Id & id : ids)
+        {
+            Signature & s = idToSignature[id];
+            s.set(0, m.hasComponent<cTransform>(id));
+            s.set(1, m.hasComponent<cPhysics>(id));
+            s.set(2, m.hasComponent<cCollideable>(id));
+        }
+    }
+
+    template <class T>
+    uint32_t getComponentId()
+    {
+        const char * handle = typeid(T).name();
+        return registeredComponents[handle];
+    }
+
+    template <class T>
+    bool hasComponent(const Id & i){return idToSignature[i][getComponentId<T>()];}
+
+    template <class T>
+    ComponentArray<T> & getComponentArray()
+    {
+        const char * handle = typeid(T).name();
+
+        return *(std::static_pointer_cast<ComponentArray<T>>(componentData[handle]));
+    }
+
+    template <class T>
+    inline T & getComponent(const Id & i)
+    {
+        const char * handle = typeid(T).name();
+
+        return (std::static_pointer_cast<ComponentArray<T>>(componentData[handle]))->get(i);
+    }
+
+private:
+
+    template <class T>
+    void add(EntityComponentSystem & m, uint32_t c)
+    {
+        const char * handle = typeid(T).name();
+
+        registeredComponents[handle] = c;
+        // shares the arrays, so only the lookups differ
+        componentData[handle] = std::shared_ptr<AbstractComponentArray>
+        (
+            &m.getComponentArray<T>(),
+            [](AbstractComponentArray *){}
+        );
+    }
+
+    std::unordered_map<Id,Signature> idToSignature;
+    std::unordered_map<const char *, uint32_t> registeredComponents;
+    std::unordered_map<const char *, std::shared_ptr<AbstractComponentArray>> componentData;
+
+};
+
+// gravityForce and applyForce's per object pattern
+template <class M>
+Real pass(M & m, const std::vector<Id> & ids)
+{
+    Real sum = 0.0;
+
+    for (const Id & id : ids)
+    {
+        if (!m.template hasComponent<cCollideable>(id))
+        {
+            continue;
+        }
+
+        cPhysics & p = m.template getComponent<cPhysics>(id);
+        cTransform & t = m.template getComponent<cTransform>(id);
+
+        p.fx += p.mass*0.01;
+        sum += t.x;
+    }
+
+    return sum;
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned repeats = 200;
+    std::vector<unsigned> sizes = {1000, 10000, 50000};
+
+    parseArguments(argc, argv, repeats, sizes);
+
+    std::default_random_engine e(31415);
+
+    std::cout << "objects, typeid keyed (ns/object), type ids (ns/object), speedup\n";
+
+    for (unsigned n : sizes)
+    {
+        EntityComponentSystem manager;
+
+        std::vector<Id> ids;
+
+        for (unsigned i = 0; i < n; i++)
+        {
+            Id id = manager.createObject();
+
+            manager.addComponent<cTransform>(id, cTransform(Real(i), 0.0, 0.0, 1.0));
+            manager.addComponent<cPhysics>(id, cPhysics(Real(i), 0.0, 0.0));
+
+            if (i % 2 == 0)
+            {
+                manager.addComponent<cCollideable>(id, cCollideable());
+            }
+
+            ids.push_back(id);
+        }
+
+        // visited out of creation order, as a system's members may be
+        std::shuffle(ids.begin(), ids.end(), e);
+
+        PreviousLookup previous(manager, ids);
+
+        Real sum = pass(previous, ids) + pass(manager, ids);
+
+        TimePoint t0 = now();
+
+        for (unsigned r = 0; r < repeats; r++)
+        {
+            sum += pass(previous, ids);
+        }
+
+        TimePoint t1 = now();
+
+        for (unsigned r = 0; r < repeats; r++)
+        {
+            sum += pass(manager, ids);
+        }
+
+        TimePoint t2 = now();
+
+        double calls = double(repeats)*n;
+
+        double before = nsPer(t0, t1, calls);
+        double after = nsPer(t1, t2, calls);
+
+        // keeps the sum live
+        if (sum < 0.0)
+        {
+            std::cout << " ";
+        }
+
+        row(n, before, after, before/after);
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <random>
+#include <memory>
+#include <unordered_map>
+#include <typeinfo>
+#include <algorithm>
+
+#include "../benchmark.h"
+
+#include <Object/entityComponentSystem.h>
+
+using Hop::Real;
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Id;
+using Hop::Object::Component::AbstractComponentArray;
+using Hop::Object::Component::ComponentArray;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::Object::Component::cCollideable;
+using Hop::System::Signature;
+
+#endif /* MAIN_H */
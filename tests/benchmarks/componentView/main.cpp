@@ -0,0 +1,231 @@
+#include "main.h"
+
+/*
+    Per object cost of a system's pass over its components, before
+    and after dense joined views.
+
+        BenchmarkComponentView [repeats] [objects ...]
+
+    Objects all have a cTransform and cPhysics, every other one a
+    cRenderable too. Before, a system walks its std::set<Id> and
+    looks each component up by id, as sPhysics did. After, it
+    walks ComponentView::each. Joins of 1, 2 and 3 components are
+    timed, each on a fresh ECS and again after a random quarter of
+    the objects are removed (so dense order is no longer creation
+    order), reported in ns per visited object.
+*/
+
+struct Timing
+{
+    double lookup;
+    double view;
+    size_t visited;
+};
+
+template <class F, class G>
+Timing time(unsigned repeats, F lookup, G view)
+{
+    Timing t;
+    t.visited = 0;
+
+    // once each to warm caches and build the views' columns
+    lookup();
+    view();
+
+    TimePoint t0 = now();
+
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        t.visited += lookup();
+    }
+
+    TimePoint t1 = now();
+
+    size_t visited = 0;
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        visited += view();
+    }
+
+    TimePoint t2 = now();
+
+    if (visited != t.visited)
+    {
+        std::cout << "view visited " << visited << " objects, lookup " << t.visited << "\n";
+    }
+
+    t.lookup = nsPer(t0, t1, t.visited);
+    t.view = nsPer(t1, t2, t.visited);
+    return t;
+}
+
+void report(std::string label, unsigned n, Timing t)
+{
+    row(n, label, t.visited, t.lookup, t.view, t.lookup/t.view);
+}
+
+void run(unsigned n, unsigned repeats, bool removals, std::default_random_engine & e)
+{
+    EntityComponentSystem manager;
+
+    std::vector<Id> ids;
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        Id id = manager.createObject();
+
+        manager.addComponent<cTransform>(id, cTransform(Real(i), 0.0, 0.0, 1.0));
+        manager.addComponent<cPhysics>(id, cPhysics(Real(i), 0.0, 0.0));
+
+        if (i % 2 == 0)
+        {
+            manager.addComponent<cRenderable>(id, cRenderable(""));
+        }
+
+        ids.push_back(id);
+    }
+
+    if (removals)
+    {
+        std::shuffle(ids.begin(), ids.end(), e);
+        for (unsigned i = 0; i < n/4; i++)
+        {
+            manager.remove(ids[i]);
+        }
+        ids.erase(ids.begin(), ids.begin()+n/4);
+    }
+
+    // the member sets systems kept, by signature
+    std::set<Id> transformed, physical, rendered;
+
+    for (const Id & id : ids)
+    {
+        transformed.insert(id);
+        physical.insert(id);
+        if (manager.hasComponent<cRenderable>(id))
+        {
+            rendered.insert(id);
+        }
+    }
+
+    ComponentArray<cTransform> & transforms = manager.getComponentArray<cTransform>();
+    ComponentArray<cPhysics> & physics = manager.getComponentArray<cPhysics>();
+    ComponentArray<cRenderable> & renderables = manager.getComponentArray<cRenderable>();
+
+    std::string suffix = removals ? ", removed" : "";
+
+    report
+    (
+        "cTransform"+suffix,
+        n,
+        time
+        (
+            repeats,
+            [&]()
+            {
+                for (const Id & id : transformed)
+                {
+                    transforms.get(id).x += 1.0;
+                }
+                return transformed.size();
+            },
+            [&]()
+            {
+                ComponentView<cTransform> & view = manager.view<cTransform>();
+                view.each
+                (
+                    [](const Id &, cTransform & t)
+                    {
+                        t.x += 1.0;
+                    }
+                );
+                return view.size();
+            }
+        )
+    );
+
+    report
+    (
+        "cTransform cPhysics"+suffix,
+        n,
+        time
+        (
+            repeats,
+            [&]()
+            {
+                for (const Id & id : physical)
+                {
+                    cTransform & t = transforms.get(id);
+                    cPhysics & p = physics.get(id);
+                    p.lastX = t.x - p.vx;
+                }
+                return physical.size();
+            },
+            [&]()
+            {
+                ComponentView<cTransform, cPhysics> & view = manager.view<cTransform, cPhysics>();
+                view.each
+                (
+                    [](const Id &, cTransform & t, cPhysics & p)
+                    {
+                        p.lastX = t.x - p.vx;
+                    }
+                );
+                return view.size();
+            }
+        )
+    );
+
+    report
+    (
+        "cTransform cPhysics cRenderable"+suffix,
+        n,
+        time
+        (
+            repeats,
+            [&]()
+            {
+                for (const Id & id : rendered)
+                {
+                    cTransform & t = transforms.get(id);
+                    cPhysics & p = physics.get(id);
+                    cRenderable & r = renderables.get(id);
+                    r.ux = t.x + p.lastX;
+                }
+                return rendered.size();
+            },
+            [&]()
+            {
+                ComponentView<cTransform, cPhysics, cRenderable> & view = manager.view<cTransform, cPhysics, cRenderable>();
+                view.each
+                (
+                    [](const Id &, cTransform & t, cPhysics & p, cRenderable & r)
+                    {
+                        r.ux = t.x + p.lastX;
+                    }
+                );
+                return view.size();
+            }
+        )
+    );
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned repeats = 200;
+    std::vector<unsigned> sizes = {1000, 10000, 90000};
+
+    parseArguments(argc, argv, repeats, sizes);
+
+    std::default_random_engine e(31415);
+
+    std::cout << "objects, join, visited, std::set and get (ns/object), view (ns/object), speedup\n";
+
+    for (unsigned n : sizes)
+    {
+        run(n, repeats, false, e);
+        run(n, repeats, true, e);
+    }
+
+    return 0;
+}
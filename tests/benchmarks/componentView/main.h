@@ -0,0 +1,23 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <random>
+#include <set>
+#include <algorithm>
+
+#include "../benchmark.h"
+
+#include <Object/entityComponentSystem.h>
+#include <Component/componentView.h>
+#include <Component/cRenderable.h>
+
+using Hop::Real;
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Id;
+using Hop::Object::Component::ComponentArray;
+using Hop::Object::Component::ComponentView;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::Object::Component::cRenderable;
+
+#endif /* MAIN_H */
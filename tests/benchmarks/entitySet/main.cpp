@@ -0,0 +1,152 @@
+#include "main.h"
+
+/*
+    System membership as a std::set<Id> against EntitySet.
+
+        BenchmarkEntitySet [repeats] [objects ...]
+
+    Times inserting every object, contains on every object,
+    iterating the members, handing the members to a detector by
+    value (as CellList took them, three times a sub step: populate
+    and the two handle calls) against by reference, and erasing
+    a random half. In ns per object.
+*/
+
+// consumes members as a detector would, so the walk is not elided
+template <class S>
+uint64_t byValue(S s)
+{
+    uint64_t sum = 0;
+    for (const Id & i : s) { sum += i.id; }
+    return sum;
+}
+
+template <class S>
+uint64_t byReference(const S & s)
+{
+    uint64_t sum = 0;
+    for (const Id & i : s) { sum += i.id; }
+    return sum;
+}
+
+struct Timing
+{
+    double insert = 0.0;
+    double contains = 0.0;
+    double iterate = 0.0;
+    double handOff = 0.0;
+    double erase = 0.0;
+    uint64_t check = 0;
+};
+
+template <class S>
+Timing run(unsigned n, unsigned repeats, const std::vector<Id> & erased, bool copy)
+{
+    Timing t;
+
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        S s;
+
+        TimePoint t0 = now();
+
+        for (uint64_t i = 1; i <= n; i++)
+        {
+            s.insert(Id(i));
+        }
+
+        TimePoint t1 = now();
+
+        for (uint64_t i = 1; i <= n; i++)
+        {
+            t.check += s.count(Id(i));
+        }
+
+        TimePoint t2 = now();
+
+        t.check += byReference(s);
+
+        TimePoint t3 = now();
+
+        for (unsigned k = 0; k < 3; k++)
+        {
+            t.check += copy ? byValue(s) : byReference(s);
+        }
+
+        TimePoint t4 = now();
+
+        for (const Id & i : erased)
+        {
+            s.erase(i);
+        }
+
+        TimePoint t5 = now();
+
+        t.insert += elapsed(t0, t1);
+        t.contains += elapsed(t1, t2);
+        t.iterate += elapsed(t2, t3);
+        t.handOff += elapsed(t3, t4);
+        t.erase += elapsed(t4, t5);
+    }
+
+    double scale = 1e9/(double(repeats)*n);
+
+    t.insert *= scale;
+    t.contains *= scale;
+    t.iterate *= scale;
+    t.handOff *= scale;
+    t.erase *= scale;
+
+    return t;
+}
+
+// std::set's contains, by the name both share
+struct IdSet : public std::set<Id>
+{
+    size_t count(const Id & i) const { return std::set<Id>::count(i); }
+};
+
+struct SparseSet : public EntitySet
+{
+    size_t count(const Id & i) const { return contains(i); }
+};
+
+int main(int argc, char ** argv)
+{
+    unsigned repeats = 20;
+    std::vector<unsigned> sizes = {1000, 10000, 50000};
+
+    parseArguments(argc, argv, repeats, sizes);
+
+    std::default_random_engine e(31415);
+
+    std::cout << "objects, container, insert, contains, iterate, "
+              << "3 hand offs, erase half (ns/object)\n";
+
+    for (unsigned n : sizes)
+    {
+        std::vector<Id> erased;
+        for (uint64_t i = 1; i <= n; i++)
+        {
+            erased.push_back(Id(i));
+        }
+        std::shuffle(erased.begin(), erased.end(), e);
+        erased.resize(n/2);
+
+        Timing a = run<IdSet>(n, repeats, erased, true);
+        Timing b = run<SparseSet>(n, repeats, erased, false);
+
+        if (a.check != b.check)
+        {
+            std::cout << "containers disagree\n";
+            return 1;
+        }
+
+        for (auto r : {std::pair("std::set by value", a), std::pair("EntitySet by reference", b)})
+        {
+            row(n, r.first, r.second.insert, r.second.contains, r.second.iterate, r.second.handOff, r.second.erase);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <random>
+#include <set>
+#include <algorithm>
+
+#include "../benchmark.h"
+
+#include <System/entitySet.h>
+
+using Hop::Object::Id;
+using Hop::System::EntitySet;
+
+#endif /* MAIN_H */
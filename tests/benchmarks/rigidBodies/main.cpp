@@ -0,0 +1,220 @@
+#include "main.h"
+
+/*
+    The per object path sPhysics::update took before the packed
+    step, one dense_hash_map lookup per component per body.
+*/
+void objectStep
+(
+    EntityComponentSystem & manager,
+    const EntitySet & objects
+)
+{
+    ComponentArray<cPhysics> & physics = manager.getComponentArray<cPhysics>();
+    ComponentArray<cTransform> & transforms = manager.getComponentArray<cTransform>();
+
+    double nx, ny, at, bt, ct;
+
+    for (auto it = objects.begin(); it != objects.end(); it++)
+    {
+        cTransform & dataT = transforms.get(*it);
+        cPhysics & dataP = physics.get(*it);
+
+        ct = dataP.translationalDrag*dt/(2.0*dataP.mass);
+        bt = 1.0/(1.0+ct);
+        at = (1.0-ct)*bt;
+
+        nx = 2.0*bt*dataT.x - at*dataP.lastX + bt*dataP.fx*dtdt/dataP.mass;
+        ny = 2.0*bt*dataT.y - at*dataP.lastY + bt*dataP.fy*dtdt/dataP.mass;
+
+        dataP.vx = (nx-dataP.lastX)/(dt*2.0);
+        dataP.vy = (ny-dataP.lastY)/(dt*2.0);
+
+        dataP.lastX = dataT.x;
+        dataP.lastY = dataT.y;
+
+        dataP.fx = 0.0;
+        dataP.fy = 0.0;
+
+        dataP.x = nx;
+        dataP.y = ny;
+
+        dataT.x = nx;
+        dataT.y = ny;
+    }
+}
+
+/*
+    The components sPhysics keeps pointers to, gathered when
+    the component arrays change (by version), not each step.
+*/
+struct Bodies
+{
+    std::vector<cTransform*> transforms;
+    std::vector<cPhysics*> physics;
+};
+
+Bodies gather(EntityComponentSystem & manager)
+{
+    Bodies bodies;
+
+    manager.view<cPhysics, cTransform>().each
+    (
+        [&](const Id &, cPhysics & dataP, cTransform & dataT)
+        {
+            bodies.transforms.push_back(&dataT);
+            bodies.physics.push_back(&dataP);
+        }
+    );
+
+    return bodies;
+}
+
+// the per object step over those pointers, without lookups
+void pointerStep(const Bodies & bodies)
+{
+    double nx, ny, at, bt, ct;
+
+    for (size_t i = 0; i < bodies.physics.size(); i++)
+    {
+        cTransform & dataT = *bodies.transforms[i];
+        cPhysics & dataP = *bodies.physics[i];
+
+        ct = dataP.translationalDrag*dt/(2.0*dataP.mass);
+        bt = 1.0/(1.0+ct);
+        at = (1.0-ct)*bt;
+
+        nx = 2.0*bt*dataT.x - at*dataP.lastX + bt*dataP.fx*dtdt/dataP.mass;
+        ny = 2.0*bt*dataT.y - at*dataP.lastY + bt*dataP.fy*dtdt/dataP.mass;
+
+        dataP.vx = (nx-dataP.lastX)/(dt*2.0);
+        dataP.vy = (ny-dataP.lastY)/(dt*2.0);
+
+        dataP.lastX = dataT.x;
+        dataP.lastY = dataT.y;
+
+        dataP.fx = 0.0;
+        dataP.fy = 0.0;
+
+        dataP.x = nx;
+        dataP.y = ny;
+
+        dataT.x = nx;
+        dataT.y = ny;
+    }
+}
+
+/*
+    The packed path sPhysics::update takes, each chunk's bodies
+    set then integrated, gathered into lanes and scattered back
+    Lanes::width at a time. Nothing persists between steps.
+*/
+void packedStep(const Bodies & bodies, RigidBodies & lanes)
+{
+    size_t n = bodies.physics.size();
+
+    for (size_t begin = 0; begin < n; begin += chunk)
+    {
+        size_t end = std::min(begin+chunk, n);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            lanes.set(i, bodies.transforms[i], bodies.physics[i]);
+        }
+
+        lanes.integrate(dt, dtdt, begin, end);
+    }
+}
+
+void populate(EntityComponentSystem & manager, unsigned n)
+{
+    std::default_random_engine e(31415);
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        Id id = manager.createObject();
+
+        double x = U(e);
+        double y = U(e);
+
+        manager.addComponent<cTransform>(id, cTransform(x, y, 0.0, 0.01));
+        manager.addComponent<cPhysics>(id, cPhysics(x, y, 0.0, 0.1, 0.0, 0.1, 1.0, 0.0));
+    }
+}
+
+void force(EntityComponentSystem & manager, const EntitySet & objects)
+{
+    for (auto it = objects.begin(); it != objects.end(); it++)
+    {
+        cPhysics & dataP = manager.getComponent<cPhysics>(*it);
+        dataP.fx += 0.1;
+        dataP.fy -= 9.81;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned steps = 1000;
+    std::vector<unsigned> sizes = {8, 1000, 10000, 50000};
+
+    parseArguments(argc, argv, steps, sizes);
+
+    std::cout << "bodies, per object (s/step), per object by pointer (s/step), packed (s/step), speedup, speedup by pointer\n";
+
+    for (unsigned n : sizes)
+    {
+        EntityComponentSystem manager;
+        populate(manager, n);
+
+        const EntitySet & objects = manager.getSystem<sPhysics>().objects;
+
+        Bodies bodies = gather(manager);
+
+        RigidBodies lanes;
+        lanes.resize(n);
+
+        TimePoint t0 = now();
+
+        for (unsigned s = 0; s < steps; s++)
+        {
+            force(manager, objects);
+            objectStep(manager, objects);
+        }
+
+        TimePoint t1 = now();
+
+        for (unsigned s = 0; s < steps; s++)
+        {
+            force(manager, objects);
+            pointerStep(bodies);
+        }
+
+        TimePoint t2 = now();
+
+        for (unsigned s = 0; s < steps; s++)
+        {
+            force(manager, objects);
+            packedStep(bodies, lanes);
+        }
+
+        TimePoint t3 = now();
+
+        // forcing is shared by every path, so time it to subtract
+        for (unsigned s = 0; s < steps; s++)
+        {
+            force(manager, objects);
+        }
+
+        TimePoint t4 = now();
+
+        double f = elapsed(t3, t4);
+        double object = (elapsed(t0, t1)-f)/steps;
+        double pointer = (elapsed(t1, t2)-f)/steps;
+        double packed = (elapsed(t2, t3)-f)/steps;
+
+        row(n, object, pointer, packed, object/packed, pointer/packed);
+    }
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include "../benchmark.h"
+
+#include <Object/entityComponentSystem.h>
+#include <System/Physics/rigidBodies.h>
+
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Id;
+using Hop::System::EntitySet;
+using Hop::Object::Component::ComponentArray;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::System::Physics::sPhysics;
+using Hop::System::Physics::RigidBodies;
+using Hop::Real;
+
+const Real dt = 1.0/900.0;
+const Real dtdt = dt*dt;
+
+// as sPhysics' UPDATE_CHUNK_SIZE
+const size_t chunk = 256;
+
+#endif /* MAIN_H */
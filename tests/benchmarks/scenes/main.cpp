@@ -0,0 +1,199 @@
+#include "main.h"
+
+/*
+    Runs Lua scenes headless and prints, as JSON, nanoseconds per
+    step per primitive in total and for each phase of the step.
+
+        BenchmarkScenes [steps] [threads] [scene.lua ...] [out.json]
+
+    Run from the repository root, the scenes require("tests/...").
+    Lua's print shares stdout, so name an out.json for clean output.
+    Phase times are only measured in BENCHMARK builds.
+*/
+
+struct Result
+{
+    std::string scene;
+    uint64_t objects, primitives;
+    double total;
+    PhysicsTimings timings;
+};
+
+Result run(std::string scene, unsigned steps, unsigned threads)
+{
+    EntityComponentSystem manager;
+
+    jLog::Log log;
+
+    Hop::Console console(log);
+
+    // an empty map walled on the bottom, left and right
+    Hop::World::FiniteBoundary<double> mapBounds(0,0,16,16,true,false,true,true);
+    Hop::World::FixedSource mapSource;
+
+    // headless, no GL context is needed
+    std::unique_ptr<AbstractWorld> world = std::make_unique<TileWorld>
+    (
+        2,
+        16,
+        1,
+        &mapSource,
+        &mapBounds
+    );
+
+    sPhysics & physics = manager.getSystem<sPhysics>();
+    physics.setTimeStep(deltaPhysics);
+    physics.setGravity(9.81, 0.0, -1.0);
+
+    sCollision & collisions = manager.getSystem<sCollision>();
+
+    collisions.setDetector(std::make_unique<CellList>(world.get()));
+    collisions.setResolver(std::make_unique<SpringDashpot>(deltaPhysics*10.0, 0.66, 0.0));
+
+    Hop::LuaExtraSpace luaStore;
+
+    luaStore.ecs = &manager;
+    luaStore.world = world.get();
+    luaStore.physics = &physics;
+    luaStore.resolver = &collisions;
+
+    console.luaStore(&luaStore);
+
+    // scenes seeded from os.time are pinned so runs compare
+    console.runString("os.time = function() return 0 end");
+    console.runFile(scene);
+
+    std::string status = console.luaStatus();
+    if (status != "LUA_OK") { std::cerr << scene << ": " << status << "\n"; }
+
+    std::unique_ptr<jThread::ThreadPool> workers;
+
+    if (threads > 0)
+    {
+        workers = std::make_unique<jThread::ThreadPool>(threads);
+    }
+
+    world->updateRegion(0.0, 0.0);
+    collisions.centreOn(world->getMapCenter());
+
+    physics.resetTimings();
+    collisions.resetTimings();
+
+    TimePoint t0 = now();
+
+    for (unsigned s = 0; s < steps; s++)
+    {
+        physics.step(&manager, &collisions, world.get(), workers.get());
+    }
+
+    TimePoint t1 = now();
+
+    Result r;
+
+    r.scene = scene;
+    r.objects = manager.getObjects().size();
+    r.primitives = 0;
+
+    ComponentArray<cCollideable> & dataC = manager.getComponentArray<cCollideable>();
+
+    for (const Id & id : collisions.objects)
+    {
+        r.primitives += dataC.get(id).mesh.size();
+    }
+
+    r.total = elapsed(t0, t1);
+    r.timings = collisions.getTimings();
+    r.timings.integration = physics.getTimings().integration;
+
+    return r;
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned steps = 1000;
+    unsigned threads = 0;
+    std::string output = "";
+
+    std::vector<std::string> scenes =
+    {
+        "tests/DEM.lua",
+        "tests/jacks.lua",
+        "tests/tetris.lua",
+        "tests/mix.lua",
+        "tests/croissant.lua",
+        "tests/squircles.lua"
+    };
+
+    std::vector<std::string> rest;
+    parseArguments(argc, argv, steps, rest);
+
+    if (rest.size() > 0)
+    {
+        threads = std::stoi(rest[0]);
+    }
+
+    if (rest.size() > 1)
+    {
+        scenes.clear();
+        for (unsigned i = 1; i < rest.size(); i++)
+        {
+            if (Hop::Util::endsWith(rest[i], ".json"))
+            {
+                output = rest[i];
+            }
+            else
+            {
+                scenes.push_back(rest[i]);
+            }
+        }
+    }
+
+    std::vector<Result> results;
+
+    for (std::string scene : scenes)
+    {
+        results.push_back(run(scene, steps, threads));
+    }
+
+    std::stringstream json;
+
+    json << "{\n"
+         << "  \"steps\": " << steps << ",\n"
+         << "  \"threads\": " << threads << ",\n"
+         << "  \"precision\": \"" << (sizeof(Hop::Real) == sizeof(float) ? "single" : "double") << "\",\n"
+         << "  \"scenes\": [\n";
+
+    for (unsigned i = 0; i < results.size(); i++)
+    {
+        const Result & r = results[i];
+
+        // ns per step per primitive
+        double n = 1e9/(double(steps)*std::max(r.primitives, uint64_t(1)));
+
+        json << "    {\n"
+             << "      \"scene\": \"" << r.scene << "\",\n"
+             << "      \"objects\": " << r.objects << ",\n"
+             << "      \"primitives\": " << r.primitives << ",\n"
+             << std::setprecision(6)
+             << "      \"total\": " << r.total*n << ",\n"
+             << "      \"integration\": " << r.timings.integration*n << ",\n"
+             << "      \"broadPhase\": " << r.timings.broadPhase*n << ",\n"
+             << "      \"narrowPhase\": " << r.timings.narrowPhase*n << ",\n"
+             << "      \"world\": " << r.timings.world*n << "\n"
+             << "    }" << (i+1 < results.size() ? "," : "") << "\n";
+    }
+
+    json << "  ]\n}\n";
+
+    if (output != "")
+    {
+        std::ofstream file(output);
+        file << json.str();
+    }
+    else
+    {
+        std::cout << json.str();
+    }
+
+    return 0;
+}
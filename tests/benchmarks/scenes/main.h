@@ -0,0 +1,42 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "../benchmark.h"
+
+#include <Object/entityComponentSystem.h>
+
+#include <System/Physics/sPhysics.h>
+#include <System/Physics/sCollision.h>
+
+#include <World/world.h>
+#include <World/tileWorld.h>
+#include <World/fixedSource.h>
+
+#include <Console/console.h>
+
+#include <jLog/jLog.h>
+#include <jThread/jThread.h>
+
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Id;
+using Hop::Object::Component::ComponentArray;
+using Hop::Object::Component::cCollideable;
+using Hop::System::Physics::sPhysics;
+using Hop::System::Physics::sCollision;
+using Hop::System::Physics::CellList;
+using Hop::System::Physics::SpringDashpot;
+using Hop::Util::PhysicsTimings;
+using Hop::World::AbstractWorld;
+using Hop::World::TileWorld;
+
+const double deltaPhysics = 1.0/900.0;
+
+#endif /* MAIN_H */
@@ -0,0 +1,210 @@
+#include "main.h"
+
+/*
+    Rectangle-rectangle narrow phase before and after caching
+    world space corners and axes per step.
+
+        BenchmarkSeparatingAxis [repeats] [rectangles ...]
+
+    Placement compares updateWorldMesh on a rigid mesh of
+    rectangles with the copy, rotate (with its square roots),
+    scale and translate it took before. The separating axis test
+    compares Maths::rectangleRectangleCollided, building Rectangles
+    by value, against rectanglesOverlap on the cached primitives,
+    over pairs whose bounding circles overlap as the resolver only
+    tests those.
+*/
+
+std::vector<RectanglePrimitive> randomRectangles(unsigned n, std::default_random_engine & e)
+{
+    std::uniform_real_distribution<Real> U(0.0, 1.0);
+
+    std::vector<RectanglePrimitive> v;
+
+    // side ~ 1/sqrt(n) so neighbours overlap some of the time
+    Real l = 1.0/std::sqrt(Real(n));
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        Real x = U(e), y = U(e), w = l*(0.5+U(e)), h = l*(0.5+U(e));
+        Real a = 6.28*U(e), c = std::cos(a), s = std::sin(a);
+
+        v.push_back
+        (
+            RectanglePrimitive
+            (
+                x, y,
+                x - h*s, y + h*c,
+                x + w*c - h*s, y + w*s + h*c,
+                x + w*c, y + w*s
+            )
+        );
+    }
+
+    return v;
+}
+
+// CollisionMesh::updateWorldMeshRigid as it was before the cached placement
+void previousUpdate(CollisionMesh & mesh, const cTransform & transform)
+{
+    Real c = std::cos(transform.theta);
+    Real s = std::sin(transform.theta);
+
+    std::vector<uint8_t> inside(mesh.size());
+
+    for (unsigned i = 0; i < mesh.size(); i++)
+    {
+        const MeshRectangle & lv = mesh.getModelVertex(i);
+
+        inside[i] = mesh[i].lastInside;
+        mesh[i].setOrigin
+        (
+            (lv.x*c + lv.y*s)*transform.scale + transform.x,
+            (lv.y*c - lv.x*s)*transform.scale + transform.y
+        );
+
+        mesh[i].r = lv.r*transform.scale;
+        mesh[i].lastInside = inside[i];
+    }
+
+    for (unsigned i = 0; i < mesh.size(); i++)
+    {
+        RectanglePrimitive & lw = mesh[i];
+        const MeshRectangle & lv = mesh.getModelVertex(i);
+
+        lw.llx = lv.llx;
+        lw.lly = lv.lly;
+
+        lw.ulx = lv.ulx;
+        lw.uly = lv.uly;
+
+        lw.urx = lv.urx;
+        lw.ury = lv.ury;
+
+        lw.lrx = lv.lrx;
+        lw.lry = lv.lry;
+
+        lw.x = lv.x;
+        lw.y = lv.y;
+        lw.r = lv.r;
+
+        lw.rotateClockWise(c, s);
+        lw.scale(transform.scale*2.0);
+        lw.translate(transform.x, transform.y);
+    }
+
+    mesh.computeRadius();
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned repeats = 200;
+    std::vector<unsigned> sizes = {16, 256, 2048};
+
+    parseArguments(argc, argv, repeats, sizes);
+
+    std::default_random_engine e(31415);
+
+    std::cout << "rectangles, "
+              << "previous placement (s/rect), cached placement (s/rect), speedup, "
+              << "candidate pairs, Maths SAT (s/pair), SIMD SAT (s/pair), speedup, overlapping\n";
+
+    for (unsigned n : sizes)
+    {
+        std::vector<RectanglePrimitive> rectangles = randomRectangles(n, e);
+
+        CollisionMesh mesh(rectangles);
+        cTransform transform(0.5, 0.5, 0.3, 0.1);
+        cPhysics physics(0.5, 0.5, 0.3);
+
+        TimePoint t0 = now();
+
+        for (unsigned r = 0; r < repeats; r++)
+        {
+            transform.theta += 0.01;
+            previousUpdate(mesh, transform);
+        }
+
+        TimePoint t1 = now();
+
+        for (unsigned r = 0; r < repeats; r++)
+        {
+            transform.theta += 0.01;
+            mesh.updateWorldMesh(transform, physics, dt);
+        }
+
+        TimePoint t2 = now();
+
+        std::vector<std::pair<unsigned, unsigned>> candidates;
+
+        for (unsigned i = 0; i < n; i++)
+        {
+            for (unsigned j = i+1; j < n; j++)
+            {
+                Real rx = rectangles[j].x-rectangles[i].x;
+                Real ry = rectangles[j].y-rectangles[i].y;
+                Real rc = rectangles[i].r+rectangles[j].r;
+
+                if (rx*rx+ry*ry < rc*rc)
+                {
+                    candidates.push_back(std::pair(i, j));
+                }
+            }
+        }
+
+        unsigned previousHits = 0, hits = 0;
+        Real previousSum = 0.0, sum = 0.0;
+        Real nx, ny, s;
+
+        TimePoint t3 = now();
+
+        for (unsigned r = 0; r < repeats; r++)
+        {
+            for (auto & p : candidates)
+            {
+                if (rectangleRectangleCollided<Real>(rectangles[p.first].getRect(), rectangles[p.second].getRect(), nx, ny, s))
+                {
+                    previousHits++;
+                    previousSum += s;
+                }
+            }
+        }
+
+        TimePoint t4 = now();
+
+        for (unsigned r = 0; r < repeats; r++)
+        {
+            for (auto & p : candidates)
+            {
+                if (rectanglesOverlap(rectangles[p.first], rectangles[p.second], nx, ny, s))
+                {
+                    hits++;
+                    sum += s;
+                }
+            }
+        }
+
+        TimePoint t5 = now();
+
+        if (hits != previousHits)
+        {
+            std::cout << "SIMD SAT found " << hits << " overlaps, Maths SAT " << previousHits << "\n";
+            return 1;
+        }
+
+        double placements = double(repeats)*n;
+        double pairs = double(repeats)*candidates.size();
+
+        double previous = elapsed(t0, t1)/placements;
+        double cached = elapsed(t1, t2)/placements;
+        double maths = elapsed(t3, t4)/pairs;
+        double simd = elapsed(t4, t5)/pairs;
+
+        // keeps the sums live
+        if (sum+previousSum < 0.0) { std::cout << " "; }
+
+        row(n, previous, cached, previous/cached, candidates.size(), maths, simd, maths/simd, hits/repeats);
+    }
+
+    return 0;
+}
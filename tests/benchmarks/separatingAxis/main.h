@@ -0,0 +1,24 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <random>
+#include <cmath>
+
+#include "../benchmark.h"
+
+#include <Collision/collisionMesh.h>
+#include <Collision/separatingAxis.h>
+#include <Maths/distance.h>
+
+using Hop::Real;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::System::Physics::CollisionMesh;
+using Hop::System::Physics::MeshRectangle;
+using Hop::System::Physics::RectanglePrimitive;
+using Hop::System::Physics::rectanglesOverlap;
+using Hop::Maths::rectangleRectangleCollided;
+
+const double dt = 1.0/900.0;
+
+#endif /* MAIN_H */
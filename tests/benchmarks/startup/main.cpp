@@ -0,0 +1,58 @@
+#include "main.h"
+
+/*
+    Time and resident memory to construct an EntityComponentSystem,
+    empty and then holding a scene of n objects.
+
+        BenchmarkStartup [objects]
+
+    Resident memory is read from /proc/self/statm (Linux), as the
+    increase over the process before the ECS is built. One scene
+    per run, as freed memory stays resident for the next.
+*/
+
+double residentMB()
+{
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return double(resident)*double(sysconf(_SC_PAGESIZE))/(1024.0*1024.0);
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned n = 0;
+
+    if (argc > 1)
+    {
+        n = std::stoi(argv[1]);
+    }
+
+    std::cout << "objects, construct (ms), populate (ms), resident (MB)\n";
+
+    double rss0 = residentMB();
+
+    TimePoint t0 = now();
+
+    std::unique_ptr<EntityComponentSystem> manager = std::make_unique<EntityComponentSystem>();
+
+    TimePoint t1 = now();
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        Id id = manager->createObject();
+
+        manager->addComponent<cTransform>(id, cTransform(Real(i), 0.0, 0.0, 1.0));
+        manager->addComponent<cPhysics>(id, cPhysics(Real(i), 0.0, 0.0));
+        manager->addComponent<cRenderable>(id, cRenderable("circleShader"));
+        manager->addComponent<cCollideable>(id, cCollideable());
+    }
+
+    TimePoint t2 = now();
+
+    double rss = residentMB()-rss0;
+
+    row(n, elapsed(t0, t1)*1e3, elapsed(t1, t2)*1e3, rss);
+
+    return 0;
+}
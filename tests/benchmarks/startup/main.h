@@ -0,0 +1,20 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <fstream>
+#include <memory>
+#include <unistd.h>
+
+#include "../benchmark.h"
+
+#include <Object/entityComponentSystem.h>
+
+using Hop::Real;
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Id;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::Object::Component::cCollideable;
+using Hop::Object::Component::cRenderable;
+
+#endif /* MAIN_H */
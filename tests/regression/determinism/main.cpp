@@ -0,0 +1,184 @@
+#include "main.h"
+
+#include <map>
+
+/*
+    Steps Lua scenes headless without a thread pool, with 1, 2,
+    4 and 8 workers, and with archetype component storage, and
+    fails unless every run gives bit identical trajectories.
+
+        TestDeterminism [steps] [scene.lua ...]
+
+    Run from the repository root, the scenes require("tests/...").
+*/
+
+// FNV-1a over the bits of every object's position, angle and velocity
+uint64_t stateHash(EntityComponentSystem & manager)
+{
+    std::map<uint64_t, std::vector<double>> state;
+
+    for (auto & object : manager.getObjects())
+    {
+        if (!manager.hasComponent<cPhysics>(object.first))
+        {
+            continue;
+        }
+
+        cTransform & t = manager.getComponent<cTransform>(object.first);
+        cPhysics & p = manager.getComponent<cPhysics>(object.first);
+
+        state[object.first.id] = {t.x, t.y, t.theta, p.vx, p.vy, p.phi};
+    }
+
+    uint64_t hash = 14695981039346656037ull;
+
+    for (auto & s : state)
+    {
+        for (double v : s.second)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(double));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+    }
+
+    return hash;
+}
+
+uint64_t run(std::string scene, unsigned steps, unsigned threads, Storage storage)
+{
+    EntityComponentSystem manager(&identityCallback, MAX_OBJECTS, storage);
+
+    jLog::Log log;
+
+    Hop::Console console(log);
+
+    // walled on the bottom, left and right
+    Hop::World::FiniteBoundary<double> mapBounds(0,0,16,16,true,false,true,true);
+    Hop::World::FixedSource mapSource;
+
+    // a floor of full and half tiles for the object-world pass
+    for (int i = 0; i < 16; i++)
+    {
+        mapSource.setAtCoordinate(i, 0, uint64_t(Tile::FULL));
+
+        if (i % 3 == 0)
+        {
+            mapSource.setAtCoordinate(i, 1, uint64_t(Tile::BOTTOM_HALF));
+        }
+    }
+
+    std::unique_ptr<AbstractWorld> world = std::make_unique<TileWorld>
+    (
+        2,
+        16,
+        1,
+        &mapSource,
+        &mapBounds
+    );
+
+    sPhysics & physics = manager.getSystem<sPhysics>();
+    physics.setTimeStep(deltaPhysics);
+    physics.setGravity(9.81, 0.0, -1.0);
+
+    sCollision & collisions = manager.getSystem<sCollision>();
+
+    collisions.setDetector(std::make_unique<CellList>(world.get()));
+    collisions.setResolver(std::make_unique<SpringDashpot>(deltaPhysics*10.0, 0.66, 0.0));
+
+    Hop::LuaExtraSpace luaStore;
+
+    luaStore.ecs = &manager;
+    luaStore.world = world.get();
+    luaStore.physics = &physics;
+    luaStore.resolver = &collisions;
+
+    console.luaStore(&luaStore);
+
+    // scenes seeded from os.time are pinned so runs compare
+    console.runString("os.time = function() return 0 end");
+    console.runFile(scene);
+
+    // no pool at all for 0 threads, the serial path
+    std::unique_ptr<jThread::ThreadPool> workers;
+
+    if (threads > 0)
+    {
+        workers = std::make_unique<jThread::ThreadPool>(threads);
+    }
+
+    world->updateRegion(0.0, 0.0);
+    collisions.centreOn(world->getMapCenter());
+
+    for (unsigned s = 0; s < steps; s++)
+    {
+        physics.step(&manager, &collisions, world.get(), workers.get());
+    }
+
+    return stateHash(manager);
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned steps = 900;
+
+    std::vector<std::string> scenes =
+    {
+        "tests/DEM.lua",
+        "tests/jacks.lua",
+        "tests/mix.lua",
+        "tests/rectangles-and-circles.lua",
+        "tests/squircles.lua"
+    };
+
+    if (argc > 1)
+    {
+        steps = std::stoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        scenes.assign(argv+2, argv+argc);
+    }
+
+    const std::vector<unsigned> threads = {0, 1, 2, 4, 8};
+
+    bool deterministic = true;
+
+    for (std::string scene : scenes)
+    {
+        uint64_t reference = 0;
+
+        for (unsigned t : threads)
+        {
+            uint64_t hash = run(scene, steps, t, Storage::COMPONENT_ARRAYS);
+
+            std::cout << scene << " threads " << t
+                      << " hash " << std::hex << hash << std::dec << "\n";
+
+            if (t == threads.front())
+            {
+                reference = hash;
+            }
+            else if (hash != reference)
+            {
+                deterministic = false;
+            }
+        }
+
+        uint64_t hash = run(scene, steps, threads.back(), Storage::ARCHETYPES);
+
+        std::cout << scene << " archetypes threads " << threads.back()
+                  << " hash " << std::hex << hash << std::dec << "\n";
+
+        deterministic = deterministic && hash == reference;
+    }
+
+    if (!deterministic)
+    {
+        std::cout << "trajectories depend on the worker count\n";
+        return 1;
+    }
+
+    return 0;
+}
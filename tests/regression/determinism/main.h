@@ -0,0 +1,41 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+
+#include <Object/entityComponentSystem.h>
+
+#include <System/Physics/sPhysics.h>
+#include <System/Physics/sCollision.h>
+
+#include <World/world.h>
+#include <World/tileWorld.h>
+#include <World/fixedSource.h>
+
+#include <Console/console.h>
+
+#include <jLog/jLog.h>
+#include <jThread/jThread.h>
+
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Storage;
+using Hop::Object::MAX_OBJECTS;
+using Hop::Object::identityCallback;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::System::Physics::sPhysics;
+using Hop::System::Physics::sCollision;
+using Hop::System::Physics::CellList;
+using Hop::System::Physics::SpringDashpot;
+using Hop::World::AbstractWorld;
+using Hop::World::TileWorld;
+using Hop::World::Tile;
+
+const double deltaPhysics = 1.0/900.0;
+
+#endif /* MAIN_H */
@@ -0,0 +1,388 @@
+#include "main.h"
+
+/*
+    Steps Lua scenes headless and fails if any object's state
+    goes non finite or blows up in speed, or if the run strays
+    too far from the double precision reference. Each scene is
+    run at a fixed time step, then adaptively in 1/60 s frames.
+
+        TestStability [steps] [scene.lua ...] [reference.txt]
+
+    Kinetic energy and the centre of the objects are sampled
+    along each run, and every object's final position kept. The
+    single precision build (-DSINGLE_PRECISION=ON) reports how
+    far these are from reference.txt, written by the double build
+    when given, so what precision costs is measured, and bounded.
+
+    Run from the repository root, the scenes require("tests/...").
+*/
+
+// far above free fall speed over any test run, only a blow up reaches it
+const double maxSpeed = 1000.0;
+
+bool stable(EntityComponentSystem & manager, std::string scene)
+{
+    for (auto & object : manager.getObjects())
+    {
+        if (!manager.hasComponent<cPhysics>(object.first))
+        {
+            continue;
+        }
+
+        cTransform & t = manager.getComponent<cTransform>(object.first);
+        cPhysics & p = manager.getComponent<cPhysics>(object.first);
+
+        for (Real v : {t.x, t.y, t.theta, p.vx, p.vy, p.phi})
+        {
+            if (!std::isfinite(v))
+            {
+                std::cout << scene << " object " << object.first.id
+                          << " has a non finite state\n";
+                return false;
+            }
+        }
+
+        if (std::sqrt(p.vx*p.vx+p.vy*p.vy) > maxSpeed)
+        {
+            std::cout << scene << " object " << object.first.id
+                      << " moving at " << p.vx << ", " << p.vy << "\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// objects' positions, by id so runs line up
+std::map<uint64_t, std::pair<double, double>> positions(EntityComponentSystem & manager)
+{
+    std::map<uint64_t, std::pair<double, double>> p;
+
+    for (auto & object : manager.getObjects())
+    {
+        if (!manager.hasComponent<cPhysics>(object.first))
+        {
+            continue;
+        }
+
+        cTransform & t = manager.getComponent<cTransform>(object.first);
+
+        p[object.first.id] = std::pair(t.x, t.y);
+    }
+
+    return p;
+}
+
+void sample(EntityComponentSystem & manager, sPhysics & physics, Trajectory & trajectory)
+{
+    double x = 0.0, y = 0.0;
+
+    auto p = positions(manager);
+
+    for (auto & q : p)
+    {
+        x += q.second.first;
+        y += q.second.second;
+    }
+
+    double n = std::max(p.size(), size_t(1));
+
+    trajectory.energy.push_back(physics.kineticEnergy());
+    trajectory.centre.push_back(x/n);
+    trajectory.centre.push_back(y/n);
+}
+
+bool run(std::string scene, unsigned steps, bool adaptive, Trajectory & trajectory)
+{
+    EntityComponentSystem manager;
+
+    jLog::Log log;
+
+    Hop::Console console(log);
+
+    // walled on the bottom, left and right
+    Hop::World::FiniteBoundary<double> mapBounds(0,0,16,16,true,false,true,true);
+    Hop::World::FixedSource mapSource;
+
+    std::unique_ptr<AbstractWorld> world = std::make_unique<TileWorld>
+    (
+        2,
+        16,
+        1,
+        &mapSource,
+        &mapBounds
+    );
+
+    sPhysics & physics = manager.getSystem<sPhysics>();
+    physics.setTimeStep(deltaPhysics);
+    physics.setGravity(9.81, 0.0, -1.0);
+
+    sCollision & collisions = manager.getSystem<sCollision>();
+
+    collisions.setDetector(std::make_unique<CellList>(world.get()));
+    collisions.setResolver(std::make_unique<SpringDashpot>(deltaPhysics*10.0, 0.66, 0.0));
+
+    Hop::LuaExtraSpace luaStore;
+
+    luaStore.ecs = &manager;
+    luaStore.world = world.get();
+    luaStore.physics = &physics;
+    luaStore.resolver = &collisions;
+
+    console.luaStore(&luaStore);
+
+    // scenes seeded from os.time are pinned so runs compare
+    console.runString("os.time = function() return 0 end");
+    console.runFile(scene);
+
+    world->updateRegion(0.0, 0.0);
+    collisions.centreOn(world->getMapCenter());
+
+    if (adaptive)
+    {
+        Hop::System::Physics::AdaptiveTimeStep limits;
+        limits.frameTime = deltaPhysics*framePhysicsSteps;
+        physics.setAdaptive(true, limits);
+        steps /= framePhysicsSteps;
+    }
+
+    trajectory.key = scene + (adaptive ? " adaptive " : " fixed ") + std::to_string(steps);
+
+    unsigned every = std::max(steps/samples, 1u);
+
+    for (unsigned s = 0; s < steps; s++)
+    {
+        physics.step(&manager, &collisions, world.get());
+
+        if ((s+1) % every == 0)
+        {
+            sample(manager, physics, trajectory);
+        }
+    }
+
+    for (auto & p : positions(manager))
+    {
+        trajectory.final.push_back(p.second.first);
+        trajectory.final.push_back(p.second.second);
+    }
+
+    std::cout << scene << (adaptive ? " adaptive" : "")
+              << " objects " << manager.getObjects().size()
+              << " energy " << physics.kineticEnergy();
+
+    if (adaptive)
+    {
+        std::cout << " sub samples " << physics.getSubSamples()
+                  << " time step " << physics.getTimeStep();
+    }
+
+    std::cout << "\n";
+
+    return stable(manager, scene);
+}
+
+/*
+    The largest deviations of a run from its reference: kinetic
+    energy relative to the reference's peak, the centre's
+    distance, and the root mean square distance of objects'
+    final positions. Fails past the bounds.
+*/
+bool compare(const Trajectory & t, const Trajectory & reference)
+{
+    if
+    (
+        t.energy.size() != reference.energy.size() ||
+        t.final.size() != reference.final.size()
+    )
+    {
+        std::cout << t.key << " does not match its reference's samples\n";
+        return false;
+    }
+
+    double peak = 0.0, energy = 0.0, centre = 0.0, rms = 0.0;
+
+    for (size_t i = 0; i < t.energy.size(); i++)
+    {
+        peak = std::max(peak, std::abs(reference.energy[i]));
+        energy = std::max(energy, std::abs(t.energy[i]-reference.energy[i]));
+
+        double rx = t.centre[2*i]-reference.centre[2*i];
+        double ry = t.centre[2*i+1]-reference.centre[2*i+1];
+
+        centre = std::max(centre, std::sqrt(rx*rx+ry*ry));
+    }
+
+    for (size_t i = 0; i < t.final.size(); i += 2)
+    {
+        double rx = t.final[i]-reference.final[i];
+        double ry = t.final[i+1]-reference.final[i+1];
+
+        rms += rx*rx+ry*ry;
+    }
+
+    energy /= std::max(peak, 1e-12);
+    rms = std::sqrt(rms/std::max(t.final.size()/2, size_t(1)));
+
+    std::cout << t.key << " deviates by energy " << energy
+              << " centre " << centre
+              << " positions (rms) " << rms << "\n";
+
+    const Bounds & b = sizeof(Real) == sizeof(double) ? doubleBounds : singleBounds;
+
+    if (energy > b.energy || centre > b.centre || rms > b.positions)
+    {
+        std::cout << t.key << " is outside the bounds for " << 8*sizeof(Real) << " bit\n";
+        return false;
+    }
+
+    return true;
+}
+
+/*
+    A reference is lines of a run's key, the series' name and
+    its values, e.g.
+
+        tests/DEM.lua fixed 1500 energy 1.2 ...
+*/
+void write(std::string file, const std::vector<Trajectory> & trajectories)
+{
+    std::ofstream out(file);
+    out << std::setprecision(10);
+
+    for (const Trajectory & t : trajectories)
+    {
+        for (auto series : {std::pair("energy", &t.energy), std::pair("centre", &t.centre), std::pair("final", &t.final)})
+        {
+            out << t.key << " " << series.first;
+            for (double v : *series.second)
+            {
+                out << " " << v;
+            }
+            out << "\n";
+        }
+    }
+}
+
+std::map<std::string, Trajectory> read(std::string file)
+{
+    std::map<std::string, Trajectory> trajectories;
+
+    std::ifstream in(file);
+    std::string line;
+
+    while (std::getline(in, line))
+    {
+        std::istringstream s(line);
+        std::string scene, mode, steps, series;
+
+        s >> scene >> mode >> steps >> series;
+
+        Trajectory & t = trajectories[scene+" "+mode+" "+steps];
+        t.key = scene+" "+mode+" "+steps;
+
+        std::vector<double> & v = series == "energy" ? t.energy : series == "centre" ? t.centre : t.final;
+
+        double x;
+        while (s >> x)
+        {
+            v.push_back(x);
+        }
+    }
+
+    return trajectories;
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned steps = 1500;
+    std::string output = "";
+
+    std::vector<std::string> scenes =
+    {
+        "tests/DEM.lua",
+        "tests/jacks.lua",
+        "tests/mix.lua",
+        "tests/rectangles-and-circles.lua",
+        "tests/stacked-rectangles.lua",
+        "tests/tetris.lua",
+        "tests/croissant.lua",
+        "tests/squircles.lua"
+    };
+
+    if (argc > 1)
+    {
+        steps = std::stoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        scenes.clear();
+        for (int i = 2; i < argc; i++)
+        {
+            if (Hop::Util::endsWith(argv[i], ".txt"))
+            {
+                output = argv[i];
+            }
+            else
+            {
+                scenes.push_back(argv[i]);
+            }
+        }
+    }
+
+    std::cout << "Real is " << 8*sizeof(Real) << " bit\n";
+
+    bool ok = true;
+
+    std::vector<Trajectory> trajectories;
+
+    for (std::string scene : scenes)
+    {
+        for (bool adaptive : {false, true})
+        {
+            trajectories.push_back(Trajectory());
+            ok = run(scene, steps, adaptive, trajectories.back()) && ok;
+        }
+    }
+
+    if (!ok)
+    {
+        std::cout << "simulation is unstable\n";
+        return 1;
+    }
+
+    if (output != "")
+    {
+        if (sizeof(Real) != sizeof(double))
+        {
+            std::cout << "references are written by the double build\n";
+            return 1;
+        }
+
+        write(output, trajectories);
+        return 0;
+    }
+
+    std::map<std::string, Trajectory> references = read(reference);
+
+    for (const Trajectory & t : trajectories)
+    {
+        auto r = references.find(t.key);
+
+        if (r == references.end())
+        {
+            std::cout << t.key << " has no reference in " << reference << "\n";
+            continue;
+        }
+
+        ok = compare(t, r->second) && ok;
+    }
+
+    if (!ok)
+    {
+        std::cout << "simulation is outside its precision bounds\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cmath>
+#include <limits>
+
+#include <Object/entityComponentSystem.h>
+
+#include <System/Physics/sPhysics.h>
+#include <System/Physics/sCollision.h>
+
+#include <World/world.h>
+#include <World/tileWorld.h>
+#include <World/fixedSource.h>
+
+#include <Console/console.h>
+
+#include <jLog/jLog.h>
+#include <jThread/jThread.h>
+
+using Hop::Object::EntityComponentSystem;
+using Hop::Object::Component::cTransform;
+using Hop::Object::Component::cPhysics;
+using Hop::System::Physics::sPhysics;
+using Hop::System::Physics::sCollision;
+using Hop::System::Physics::CellList;
+using Hop::System::Physics::SpringDashpot;
+using Hop::World::AbstractWorld;
+using Hop::World::TileWorld;
+using Hop::Real;
+
+const double deltaPhysics = 1.0/900.0;
+
+// fixed steps per 1/60 s frame, for the adaptive runs
+const unsigned framePhysicsSteps = 15;
+
+// samples of energy and centre along each run
+const unsigned samples = 10;
+
+// written by the double build, TestStability 1500 [scenes ...] reference.txt
+const std::string reference = "tests/regression/stability/reference.txt";
+
+struct Trajectory
+{
+    std::string key;
+    std::vector<double> energy;
+    // x, y of each sample
+    std::vector<double> centre;
+    // x, y of each object at the end, by id
+    std::vector<double> final;
+};
+
+// largest deviations from the reference a build may show
+struct Bounds
+{
+    double energy, centre, positions;
+};
+
+const Bounds doubleBounds = {1e-6, 1e-6, 1e-6};
+
+/*
+    About twice the worst seen, 0.79 and 3.0 (tetris and mix at
+    a fixed step). Single objects' paths diverge chaotically in
+    the piles, so positions are only reported.
+*/
+const Bounds singleBounds = {1.5, 6.0, std::numeric_limits<double>::infinity()};
+
+#endif /* MAIN_H */
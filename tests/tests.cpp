@@ -11,21 +11,16 @@ const double tol = 1e-6;
 #include <Maths/polygon.h>
 #include <Maths/triangulation.h>
 #include <Collision/collisionMesh.h>
+#include <Collision/contactBuffer.h>
+#include <Collision/collisionLog.h>
+#include <Collision/separatingAxis.h>
+#include <System/Physics/rigidBodies.h>
+#include <Component/componentView.h>
+#include <Component/chunkedArray.h>
+#include <System/entitySet.h>
+#include <Util/typeIndex.h>
 
 
-namespace Hop::System::Physics
-{
-    std::ostream & operator<<(std::ostream & o, Hop::System::Physics::RectanglePrimitive const & r)
-    {
-        o << r.ulx << ", " << r.uly << "    " << r.urx << ", " << r.ury << "\n"
-            << r.llx << ", " << r.lly << "    " << r.lrx << ", " << r.lry << "\n"
-            << r.x   << ", " << r.y   << ", "   << r.r << "\n"
-            << r.axis1x << ", " << r.axis1y << ", " << r.axis2x << ", " << r.axis2y << "\n";
-
-        return o;
-    }
-}
-
 using namespace Hop::Maths;
 using namespace Hop::World;
 using namespace Hop::System::Physics;
@@ -634,4 +629,839 @@ SCENARIO("Triangulation", "[maths]")
         }
 
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Collision mesh storage", "[collision]")
+{
+    using Hop::System::Physics::CollisionMesh;
+    using Hop::System::Physics::CollisionPrimitive;
+    using Hop::System::Physics::RectanglePrimitive;
+    using Hop::System::Physics::PrimitiveType;
+
+    GIVEN("A mesh of a circle (tag 0), a rectangle (tag 1) and a circle (tag 1)")
+    {
+        std::vector<CollisionPrimitive> v = 
+        {
+            CollisionPrimitive(0.0, 0.0, 0.1, 0),
+            RectanglePrimitive
+            (
+                0.5, 0.0,
+                0.5, 0.2,
+                0.7, 0.2,
+                0.7, 0.0,
+                1
+            ),
+            CollisionPrimitive(1.0, 1.0, 0.1, 1)
+        };
+
+        CollisionMesh mesh(v, 0.0, 0.0, 0.0, 1.0);
+
+        THEN("Primitives are stored in order with their types")
+        {
+            REQUIRE(mesh.size() == size_t(3));
+            REQUIRE(mesh[0].type == PrimitiveType::CIRCLE);
+            REQUIRE(mesh[1].type == PrimitiveType::RECTANGLE);
+            REQUIRE(mesh[2].type == PrimitiveType::CIRCLE);
+            REQUIRE(mesh.getModelVertex(1).isRectangle());
+            REQUIRE(mesh.areSomeRectangles());
+        }
+        AND_THEN("Tag 1 is at indices 1 and 2")
+        {
+            auto idx = mesh.getByTag(1);
+            REQUIRE(idx.size() == size_t(2));
+            REQUIRE(idx[0] == size_t(1));
+            REQUIRE(idx[1] == size_t(2));
+        }
+        WHEN("A force is applied through an index")
+        {
+            mesh[2].applyForce(1.0, -1.0);
+            THEN("The mesh's primitive holds it")
+            {
+                REQUIRE(mesh.getMeshVertex(2).fx == 1.0);
+                REQUIRE(mesh.getMeshVertex(2).fy == -1.0);
+            }
+        }
+        WHEN("Tag 1 is removed")
+        {
+            mesh.removeByTag(1);
+            THEN("Only the first circle remains")
+            {
+                REQUIRE(mesh.size() == size_t(1));
+                REQUIRE(mesh[0].type == PrimitiveType::CIRCLE);
+                REQUIRE(mesh.getByTag(1).size() == size_t(0));
+            }
+        }
+    }
+}
+
+SCENARIO("Contact buffer", "[collision]")
+{
+    using Hop::System::Physics::ContactBuffer;
+    using Hop::System::Physics::ContactType;
+    using Hop::System::Physics::Contact;
+    using Hop::System::Physics::CollisionPrimitive;
+    using Hop::Object::Component::cPhysics;
+    using Hop::Object::Id;
+
+    GIVEN("A contact from a rigid object onto a soft object's primitive")
+    {
+        cPhysics rigid(0.0, 0.0, 0.0);
+        cPhysics soft(1.0, 0.0, 0.0);
+
+        CollisionPrimitive ca(0.0, 0.0, 0.5);
+        CollisionPrimitive cb(1.0, 0.0, 0.5, 0, 1.0);
+
+        ContactBuffer contacts;
+
+        contacts.add
+        (
+            Id(1), 0,
+            Id(2), 3,
+            &rigid, &soft,
+            &ca, &cb,
+            false, true,
+            ContactType::CIRCLE,
+            1.0, 0.0, 0.25,
+            1.0,
+            0.5, 0.0,
+            -1.0, 0.0,
+            0.0, 0.0,
+            0.0, 0.0,
+            0.0, 0.0
+        );
+
+        REQUIRE(contacts.size() == size_t(1));
+
+        contacts.fax[0] = -2.0;
+        contacts.fay[0] = 0.5;
+        contacts.fbx[0] = -2.0;
+        contacts.fby[0] = 0.5;
+        contacts.tauA[0] = 0.1;
+        contacts.tauB[0] = 0.2;
+        contacts.fpx[0] = -2.0;
+        contacts.fpy[0] = 0.5;
+        contacts.active[0] = 1;
+
+        WHEN("It is applied")
+        {
+            contacts.apply();
+
+            THEN("The rigid object takes its force and torque whole")
+            {
+                REQUIRE(rigid.fx == -2.0);
+                REQUIRE(rigid.fy == 0.5);
+                REQUIRE(rigid.tau == Hop::Real(-0.1));
+                REQUIRE(ca.fx == 0.0);
+            }
+            AND_THEN("The soft object is forced through its primitive only")
+            {
+                REQUIRE(soft.fx == 0.0);
+                REQUIRE(soft.tau == 0.0);
+                REQUIRE(cb.fx == 2.0);
+                REQUIRE(cb.fy == -0.5);
+            }
+        }
+        WHEN("It is inactive")
+        {
+            contacts.active[0] = 0;
+            contacts.apply();
+
+            THEN("Only the primitive force is applied")
+            {
+                REQUIRE(rigid.fx == 0.0);
+                REQUIRE(rigid.tau == 0.0);
+                REQUIRE(cb.fx == 2.0);
+            }
+        }
+        WHEN("It is read back")
+        {
+            Contact c = contacts[0];
+
+            THEN("It is directed from i to j with its force on i")
+            {
+                REQUIRE(c.i.id == uint64_t(1));
+                REQUIRE(c.j.id == uint64_t(2));
+                REQUIRE(c.pj == uint64_t(3));
+                REQUIRE(c.nx == 1.0);
+                REQUIRE(c.overlap == 0.25);
+                REQUIRE(c.vx == -1.0);
+                REQUIRE(c.fx == -2.0);
+            }
+        }
+    }
+}
+
+SCENARIO("Collision log", "[collision]")
+{
+    using Hop::System::Physics::CollisionLog;
+    using Hop::System::Physics::CollisionType;
+    using Hop::Object::Id;
+    using Hop::Object::NULL_ID;
+
+    GIVEN("Collisions recorded per primitive pair, out of order")
+    {
+        CollisionLog log;
+
+        log.insert(std::pair(Id(2), CollisionType(Id(1), false)));
+        log.insert(std::pair(Id(1), CollisionType(Id(2), false)));
+        log.insert(std::pair(Id(3), CollisionType(NULL_ID, true)));
+        log.insert(std::pair(Id(2), CollisionType(Id(1), false)));
+        log.insert(std::pair(Id(1), CollisionType(Id(2), false)));
+        log.insert(std::pair(Id(2), CollisionType(NULL_ID, true)));
+
+        THEN("Repeats are dropped as they are inserted")
+        {
+            REQUIRE(log.size() == 4);
+        }
+
+        THEN("Lookups are right before it is sorted")
+        {
+            REQUIRE(std::distance(log.equal_range(Id(1)).first, log.equal_range(Id(1)).second) == 1);
+            REQUIRE(log.contains(Id(3)));
+            REQUIRE(!log.contains(Id(4)));
+        }
+
+        WHEN("It is sorted")
+        {
+            log.sort();
+
+            THEN("Each object pair and world collision is kept once")
+            {
+                REQUIRE(log.size() == 4);
+
+                auto range = log.equal_range(Id(2));
+
+                REQUIRE(std::distance(range.first, range.second) == 2);
+                REQUIRE(range.first->second.world);
+                REQUIRE((range.first+1)->second.with.id == uint64_t(1));
+
+                REQUIRE(log.contains(Id(1)));
+                REQUIRE(log.contains(Id(3)));
+                REQUIRE(!log.contains(Id(4)));
+            }
+
+            AND_WHEN("It is cleared")
+            {
+                log.clear();
+
+                THEN("Nothing has collided")
+                {
+                    REQUIRE(log.size() == 0);
+                    REQUIRE(!log.contains(Id(1)));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Separating axis", "[collision]")
+{
+    using Hop::System::Physics::RectanglePrimitive;
+    using Hop::System::Physics::CollisionMesh;
+    using Hop::System::Physics::rectanglesOverlap;
+    using Hop::Maths::rectangleRectangleCollided;
+    using Hop::Real;
+
+    GIVEN("Random pairs of rotated rectangles")
+    {
+        std::default_random_engine e(1234);
+        std::uniform_real_distribution<Real> U(0.0, 1.0);
+
+        auto random = [&]()
+        {
+            Real x = U(e), y = U(e), w = 0.05+0.2*U(e), h = 0.05+0.2*U(e);
+            Real a = 6.28*U(e), c = std::cos(a), s = std::sin(a);
+            return RectanglePrimitive
+            (
+                x, y,
+                x - h*s, y + h*c,
+                x + w*c - h*s, y + w*s + h*c,
+                x + w*c, y + w*s
+            );
+        };
+
+        THEN("The kernel agrees with Maths::rectangleRectangleCollided")
+        {
+            unsigned hits = 0;
+            bool agree = true;
+
+            // exact in double, the reference projects in double for float builds
+            const Real tol = sizeof(Real) == sizeof(double) ? 0.0 : 1e-5;
+
+            for (unsigned i = 0; i < 2000; i++)
+            {
+                RectanglePrimitive r1 = random();
+                RectanglePrimitive r2 = random();
+
+                Real nx, ny, s, nxr, nyr, sr;
+
+                bool collided = rectanglesOverlap(r1, r2, nx, ny, s);
+                bool reference = rectangleRectangleCollided<Real>(r1.getRect(), r2.getRect(), nxr, nyr, sr);
+
+                if (collided != reference)
+                {
+                    // only touching rectangles may disagree in float
+                    agree = agree && std::abs(collided ? s : sr) <= tol;
+                }
+                else if (collided)
+                {
+                    hits++;
+                    // near ties may pick another axis in float
+                    agree = agree && std::abs(s-sr) <= tol && (tol > 0.0 || (nx == nxr && ny == nyr));
+                }
+            }
+
+            REQUIRE(agree);
+            REQUIRE(hits > 0);
+        }
+    }
+
+    GIVEN("A mesh with a rectangle, rotated and translated")
+    {
+        std::vector<RectanglePrimitive> v =
+        {
+            RectanglePrimitive
+            (
+                -0.25, -0.25,
+                -0.25, 0.25,
+                0.25, 0.25,
+                0.25, -0.25
+            )
+        };
+
+        CollisionMesh mesh(v, 0.5, 0.25, 0.3, 0.1);
+
+        THEN("Its world rectangle is centred on the mesh with unit axes")
+        {
+            REQUIRE(std::abs(mesh[0].x-0.5) < 1e-6);
+            REQUIRE(std::abs(mesh[0].y-0.25) < 1e-6);
+            REQUIRE(std::abs(mesh[0].width()-0.1) < 1e-6);
+            REQUIRE(std::abs(mesh[0].axis1x*mesh[0].axis1x+mesh[0].axis1y*mesh[0].axis1y-1.0) < 1e-6);
+            REQUIRE(std::abs(mesh[0].axis1x*mesh[0].axis2x+mesh[0].axis1y*mesh[0].axis2y) < 1e-6);
+        }
+    }
+}
+
+SCENARIO("Soft mesh sub cycling", "[collision]")
+{
+    using Hop::System::Physics::CollisionMesh;
+    using Hop::System::Physics::CollisionPrimitive;
+    using Hop::Object::Component::cTransform;
+    using Hop::Object::Component::cPhysics;
+    using Hop::Real;
+
+    auto ring = [](Real stiffness)
+    {
+        std::vector<CollisionPrimitive> v;
+        for (unsigned i = 0; i < 12; i++)
+        {
+            Real a = 2.0*M_PI*i/12.0;
+            v.push_back(CollisionPrimitive(0.5*std::cos(a), 0.5*std::sin(a), 0.1, 0, stiffness, 1.0, 0.01));
+        }
+        return CollisionMesh(v, 0.5, 0.5, 0.0, 0.1);
+    };
+
+    // push the ring up for 0.1 s, maybe kick one primitive at 0.5 s, to 1 s
+    auto run = [&](Real stiffness, Real dt, unsigned subCycles, bool kick, cTransform & t)
+    {
+        CollisionMesh mesh = ring(stiffness);
+        cPhysics p(t.x, t.y, t.theta);
+        p.mass = 0.12;
+        p.translationalDrag = 0.0;
+        p.rotationalDrag = 0.0;
+
+        mesh.updateWorldMesh(t, p, dt, subCycles);
+
+        unsigned steps = std::round(1.0/dt);
+        for (unsigned s = 0; s < steps; s++)
+        {
+            if (s*dt < 0.1)
+            {
+                mesh.applyForce(0.0, 1.0, true);
+            }
+            if (kick && s == steps/2)
+            {
+                mesh[0].x += 0.01;
+            }
+            mesh.updateWorldMesh(t, p, dt, subCycles);
+        }
+    };
+
+    GIVEN("A soft ring of circles")
+    {
+        WHEN("It is stepped with a time step its springs resolve")
+        {
+            cTransform single(0.5, 0.5, 0.0, 0.1);
+            cTransform cycled(0.5, 0.5, 0.0, 0.1);
+
+            run(1e3, 1.0/900.0, 1, false, single);
+            run(1e3, 1.0/900.0, 4, false, cycled);
+
+            THEN("Sub cycling its springs moves it the same way")
+            {
+                // round off in float builds sets the ring drifting either way
+                const Real tol = sizeof(Real) == sizeof(double) ? 1e-3 : 0.25;
+
+                REQUIRE(std::abs(single.x-cycled.x) < tol);
+                REQUIRE(std::abs(single.y-cycled.y) < tol);
+            }
+        }
+        WHEN("It is stepped with a time step too long for its springs")
+        {
+            cTransform single(0.5, 0.5, 0.0, 0.1);
+            cTransform cycled(0.5, 0.5, 0.0, 0.1);
+
+            run(1e3, 1.0/450.0, 1, true, single);
+            run(1e3, 1.0/450.0, 4, true, cycled);
+
+            THEN("It blows up, unless its springs sub cycle")
+            {
+                REQUIRE(!(std::abs(single.y-2.08) < 1.0));
+                REQUIRE(std::abs(cycled.y-2.08) < 0.1);
+            }
+        }
+    }
+}
+
+SCENARIO("Rigid body step", "[physics]")
+{
+    using Hop::System::Physics::RigidBodies;
+    using Hop::Object::Component::cTransform;
+    using Hop::Object::Component::cPhysics;
+    using Hop::Real;
+
+    const Real dt = 1.0/900.0;
+    const Real dtdt = dt*dt;
+
+    // whole lanes and a tail at every width
+    const unsigned n = 11;
+
+    std::vector<cTransform> transforms;
+    std::vector<cPhysics> physics;
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        transforms.push_back(cTransform(0.1*i, 0.5, 0.0, 0.01));
+        physics.push_back(cPhysics(0.1*i, 0.5, 0.0));
+        physics[i].lastX = 0.1*i-0.001;
+        physics[i].mass = 1.0+i;
+        physics[i].translationalDrag = 0.1*i;
+        physics[i].fx = 1.0;
+        physics[i].fy = -9.81;
+    }
+
+    RigidBodies bodies;
+    bodies.resize(n);
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        bodies.set(i, &transforms[i], &physics[i]);
+    }
+
+    GIVEN("Bodies with forces and drag")
+    {
+        std::vector<cTransform> t0 = transforms;
+        std::vector<cPhysics> p0 = physics;
+
+        WHEN("They are stepped")
+        {
+            bodies.integrate(dt, dtdt);
+
+            THEN("Each moves as the scalar Verlet step, and its forces are spent")
+            {
+                for (unsigned i = 0; i < n; i++)
+                {
+                    Real ct = p0[i].translationalDrag*dt/(2.0*p0[i].mass);
+                    Real bt = 1.0/(1.0+ct);
+                    Real at = (1.0-ct)*bt;
+
+                    Real x = 2.0*bt*t0[i].x-at*p0[i].lastX+bt*p0[i].fx*dtdt/p0[i].mass;
+                    Real y = 2.0*bt*t0[i].y-at*p0[i].lastY+bt*p0[i].fy*dtdt/p0[i].mass;
+
+                    REQUIRE(std::abs(transforms[i].x-x) < tol);
+                    REQUIRE(std::abs(transforms[i].y-y) < tol);
+                    REQUIRE(std::abs(physics[i].vx-(x-p0[i].lastX)/(2.0*dt)) < 1e-3);
+                    REQUIRE(physics[i].lastX == t0[i].x);
+                    REQUIRE(physics[i].lastY == t0[i].y);
+                    REQUIRE(physics[i].fx == 0.0);
+                    REQUIRE(physics[i].fy == 0.0);
+                }
+            }
+        }
+
+        WHEN("Their components are written between steps")
+        {
+            bodies.integrate(dt, dtdt);
+
+            for (unsigned i = 0; i < n; i++)
+            {
+                transforms[i].x = 5.0;
+                physics[i].lastX = 5.0;
+                physics[i].mass = 2.0;
+            }
+
+            bodies.integrate(dt, dtdt);
+
+            THEN("The next step starts from what was written")
+            {
+                for (unsigned i = 0; i < n; i++)
+                {
+                    REQUIRE(std::abs(transforms[i].x-5.0) < tol);
+                    REQUIRE(physics[i].lastX == 5.0);
+                    REQUIRE(std::abs(physics[i].vx) < 1e-3);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Component view", "[ecs]")
+{
+    using Hop::Real;
+    using Hop::Object::Id;
+    using Hop::Object::Component::ComponentArray;
+    using Hop::Object::Component::ComponentView;
+    using Hop::Object::Component::cTransform;
+    using Hop::Object::Component::cPhysics;
+
+    GIVEN("Transforms for objects 1 to 6 and physics for the even ones to 8")
+    {
+        ComponentArray<cTransform> transforms(16);
+        ComponentArray<cPhysics> physics(16);
+
+        for (uint64_t i = 1; i <= 8; i++)
+        {
+            Id id(i);
+
+            if (i <= 6)
+            {
+                transforms.insert(id, cTransform(Real(i), 0.0, 0.0, 1.0));
+            }
+
+            if (i % 2 == 0)
+            {
+                physics.insert(id, cPhysics(Real(i), 0.0, 0.0));
+            }
+        }
+
+        ComponentView<cTransform, cPhysics> view(transforms, physics);
+
+        THEN("It visits the objects with both, each with its own components")
+        {
+            std::vector<uint64_t> visited;
+
+            view.each
+            (
+                [&](const Id & id, cTransform & t, cPhysics & p)
+                {
+                    visited.push_back(id.id);
+                    REQUIRE(t.x == Real(id.id));
+                    REQUIRE(p.lastX == Real(id.id));
+                }
+            );
+
+            REQUIRE(view.size() == 3);
+            REQUIRE(visited == std::vector<uint64_t>{2, 4, 6});
+        }
+
+        WHEN("A transform is removed")
+        {
+            Id id(4);
+            transforms.remove(id);
+
+            THEN("The view no longer visits it")
+            {
+                std::vector<Id> ids = view.getIds();
+
+                REQUIRE(ids.size() == 2);
+                REQUIRE(ids[0].id == uint64_t(2));
+                REQUIRE(ids[1].id == uint64_t(6));
+            }
+        }
+
+        THEN("An optional column indexes the objects which have it")
+        {
+            ComponentView<cTransform> all(transforms);
+
+            const std::vector<uint64_t> & column = all.optional(physics);
+
+            REQUIRE(column.size() == 6);
+
+            for (size_t r = 0; r < column.size(); r++)
+            {
+                const Id & id = all.getIds()[r];
+
+                if (id.id % 2 == 0)
+                {
+                    REQUIRE(physics.idAtIndex(column[r]).id == id.id);
+                }
+                else
+                {
+                    REQUIRE(column[r] == ComponentView<cTransform>::NO_INDEX);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Entity set", "[ecs]")
+{
+    using Hop::Object::Id;
+    using Hop::System::EntitySet;
+
+    GIVEN("Ids inserted out of order, some twice, across sparse pages")
+    {
+        EntitySet set;
+
+        std::vector<uint64_t> ids = {5, 1, 9000, 3, 5, 1, 20000};
+
+        size_t inserted = 0;
+        for (uint64_t i : ids)
+        {
+            inserted += set.insert(Id(i));
+        }
+
+        THEN("Each is a member once, in insertion order")
+        {
+            REQUIRE(inserted == 5);
+            REQUIRE(set.size() == 5);
+
+            std::vector<uint64_t> members;
+            for (const Id & i : set)
+            {
+                members.push_back(i.id);
+            }
+
+            REQUIRE(members == std::vector<uint64_t>{5, 1, 9000, 3, 20000});
+
+            REQUIRE(set.contains(Id(9000)));
+            REQUIRE(!set.contains(Id(2)));
+            REQUIRE(!set.contains(Id(50000)));
+        }
+
+        WHEN("A member is erased")
+        {
+            REQUIRE(set.erase(Id(1)));
+            REQUIRE(!set.erase(Id(1)));
+
+            THEN("The last member takes its place")
+            {
+                REQUIRE(set.size() == 4);
+                REQUIRE(!set.contains(Id(1)));
+                REQUIRE(set[1].id == uint64_t(20000));
+                REQUIRE(set.contains(Id(20000)));
+
+                REQUIRE(set.erase(Id(20000)));
+                REQUIRE(set.size() == 3);
+                REQUIRE(set[1].id == uint64_t(3));
+            }
+        }
+
+        WHEN("It is copied and cleared")
+        {
+            EntitySet copy = set;
+            set.clear();
+
+            THEN("The copy keeps the members")
+            {
+                REQUIRE(set.empty());
+                REQUIRE(!set.contains(Id(5)));
+                REQUIRE(copy.size() == 5);
+                REQUIRE(copy.contains(Id(5)));
+                REQUIRE(!(copy == set));
+
+                set.insert(Id(5));
+                REQUIRE(set.size() == 1);
+                REQUIRE(set[0].id == uint64_t(5));
+            }
+        }
+    }
+}
+
+SCENARIO("Type index", "[ecs]")
+{
+    using Hop::Util::TypeIndex;
+
+    struct A; struct B; struct C;
+
+    GIVEN("Two families of type indices")
+    {
+        struct First;
+        struct Second;
+
+        uint32_t a = TypeIndex<First>::of<A>();
+        uint32_t b = TypeIndex<First>::of<B>();
+        uint32_t c = TypeIndex<Second>::of<C>();
+
+        THEN("Each family counts from 0 in order of first use")
+        {
+            REQUIRE(a == 0);
+            REQUIRE(b == 1);
+            REQUIRE(c == 0);
+        }
+
+        THEN("A type keeps its index")
+        {
+            REQUIRE(TypeIndex<First>::of<A>() == a);
+            REQUIRE(TypeIndex<Second>::of<A>() == 1);
+            REQUIRE(TypeIndex<First>::of<B>() == b);
+        }
+    }
+}
+
+SCENARIO("Chunked component storage", "[ecs]")
+{
+    using Hop::Real;
+    using Hop::Object::Id;
+    using Hop::Object::Component::ChunkedArray;
+    using Hop::Object::Component::ComponentArray;
+    using Hop::Object::Component::ComponentArrayFull;
+    using Hop::Object::Component::cTransform;
+
+    GIVEN("A chunked array of chunks of 6, rounded to 8")
+    {
+        ChunkedArray<uint64_t> a(6);
+
+        REQUIRE(a.chunkSize() == 8);
+        REQUIRE(a.capacity() == 0);
+
+        WHEN("It is grown to hold 20 elements")
+        {
+            a.reserve(20);
+            for (uint64_t k = 0; k < 20; k++)
+            {
+                a[k] = k;
+            }
+
+            uint64_t * first = &a[0];
+
+            a.reserve(100);
+
+            THEN("Whole chunks are added and elements stay put")
+            {
+                REQUIRE(a.capacity() == 104);
+                REQUIRE(&a[0] == first);
+                for (uint64_t k = 0; k < 20; k++)
+                {
+                    REQUIRE(a[k] == k);
+                }
+            }
+
+            AND_WHEN("It is copied and shrunk to 9 elements")
+            {
+                ChunkedArray<uint64_t> b = a;
+                a.shrink(9);
+
+                THEN("Chunks past them are freed and the copy is whole")
+                {
+                    REQUIRE(a.capacity() == 16);
+                    REQUIRE(a[8] == 8);
+                    REQUIRE(b.capacity() == 104);
+                    REQUIRE(b[19] == 19);
+                    REQUIRE(&b[0] != first);
+                }
+            }
+        }
+    }
+
+    GIVEN("A component array of at most 5 in chunks of 2")
+    {
+        ComponentArray<cTransform> transforms(5, 2);
+
+        REQUIRE(transforms.capacity() == 0);
+
+        for (uint64_t i = 1; i <= 5; i++)
+        {
+            Id id(i);
+            transforms.insert(id, cTransform(Real(i), 0.0, 0.0, 1.0));
+        }
+
+        THEN("Storage grew to hold them and no more may be added")
+        {
+            REQUIRE(transforms.capacity() == 6);
+            REQUIRE(transforms.get(Id(5)).x == Real(5));
+
+            Id id(6);
+            REQUIRE_THROWS_AS(transforms.insert(id, cTransform()), ComponentArrayFull);
+        }
+
+        WHEN("All but one are removed")
+        {
+            for (uint64_t i = 2; i <= 5; i++)
+            {
+                Id id(i);
+                transforms.remove(id);
+            }
+
+            THEN("Chunks are freed, keeping one spare")
+            {
+                REQUIRE(transforms.size() == 1);
+                REQUIRE(transforms.capacity() == 4);
+                REQUIRE(transforms.get(Id(1)).x == Real(1));
+            }
+        }
+    }
+
+    GIVEN("A component array limited past 32 bits")
+    {
+        const uint64_t limit = (uint64_t(1) << 32) + 7;
+
+        ComponentArray<cTransform> transforms(limit, 2);
+        ComponentArray<cTransform> copy(transforms);
+
+        THEN("The limit is kept, and by a copy")
+        {
+            REQUIRE(transforms.getMaxObjects() == limit);
+            REQUIRE(copy.getMaxObjects() == limit);
+        }
+    }
+}
+
+SCENARIO("Component array arrangement", "[ecs]")
+{
+    using Hop::Real;
+    using Hop::Object::Id;
+    using Hop::Object::Component::ComponentArray;
+    using Hop::Object::Component::cTransform;
+
+    GIVEN("A component array of 6 in chunks of 4")
+    {
+        ComponentArray<cTransform> transforms(6, 4);
+
+        for (uint64_t i = 1; i <= 6; i++)
+        {
+            Id id(i);
+            transforms.insert(id, cTransform(Real(i), 0.0, 0.0, 1.0));
+        }
+
+        uint64_t version = transforms.getVersion();
+
+        WHEN("It is arranged in the order 5, 3, 1")
+        {
+            transforms.arrange({Id(5), Id(3), Id(1)});
+
+            THEN("They lead, the rest follow, and lookups still hold")
+            {
+                REQUIRE(transforms.size() == 6);
+                REQUIRE(transforms.idAtIndex(0).id == 5);
+                REQUIRE(transforms.idAtIndex(1).id == 3);
+                REQUIRE(transforms.idAtIndex(2).id == 1);
+                REQUIRE(transforms.getVersion() != version);
+
+                for (uint64_t i = 1; i <= 6; i++)
+                {
+                    REQUIRE(transforms.get(Id(i)).x == Real(i));
+                    REQUIRE(transforms.idAtIndex(transforms.indexOf(Id(i))).id == i);
+                }
+            }
+
+            THEN("Adjacent indices run to the end of their chunk")
+            {
+                REQUIRE(transforms.contiguousFrom(0) == 4);
+                REQUIRE(transforms.contiguousFrom(3) == 1);
+                REQUIRE(transforms.contiguousFrom(5) == 3);
+                REQUIRE(&transforms.atIndex(2) == &transforms.atIndex(0)+2);
+            }
+        }
+    }
+}
@@ -89,9 +89,9 @@ int main(int argc, char ** argv)
     manager.addComponent<cRenderable>(oid, cRenderable("circleObjectShader", 0.75, 0.75, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0));
     manager.addComponent<cPhysics>(oid, cPhysics(0.5, 0.5, 0.0));
 
-    std::vector<std::shared_ptr<CollisionPrimitive>> mesh
+    std::vector<CollisionPrimitive> mesh
     {
-        std::make_shared<CollisionPrimitive>
+        CollisionPrimitive
         (
             0.0, 0.0, primitiveSize
         )
@@ -136,8 +136,8 @@ int main(int argc, char ** argv)
             double y = 0.0;
             for (unsigned i = 0; i < object.mesh.size(); i++)
             {
-                x += object.mesh.getModelVertex(i)->x;
-                y += object.mesh.getModelVertex(i)->y;
+                x += object.mesh.getModelVertex(i).x;
+                y += object.mesh.getModelVertex(i).y;
             }
             x /= object.mesh.size();
             y /= object.mesh.size();
@@ -145,10 +145,10 @@ int main(int argc, char ** argv)
             file << "{\n";
             for (unsigned i = 0; i < object.mesh.size(); i++)
             {
-                file << "    {" << object.mesh.getModelVertex(i)->x - x
-                     << ", " << object.mesh.getModelVertex(i)->y - y
-                     << ", " << object.mesh.getModelVertex(i)->r
-                     << ", " << object.mesh.getMeshVertex(i)->tag
+                file << "    {" << object.mesh.getModelVertex(i).x - x
+                     << ", " << object.mesh.getModelVertex(i).y - y
+                     << ", " << object.mesh.getModelVertex(i).r
+                     << ", " << object.mesh.getMeshVertex(i).tag
                      << "}";
 
                 if (i < object.mesh.size()-1)
@@ -204,11 +204,11 @@ int main(int argc, char ** argv)
             int clicked = object.mesh.clicked(activeSite.first, activeSite.second);
             if (clicked != -1)
             {
-                auto c = object.mesh.getMeshVertex(clicked);
+                CollisionPrimitive & c = object.mesh.getMeshVertex(clicked);
 
-                if (c->tag >= 1)
+                if (c.tag >= 1)
                 {
-                    c->tag -= 1;
+                    c.tag -= 1;
                 }
             }
         }
@@ -218,9 +218,9 @@ int main(int argc, char ** argv)
             int clicked = object.mesh.clicked(activeSite.first, activeSite.second);
             if (clicked != -1)
             {
-                auto c = object.mesh.getMeshVertex(clicked);
+                CollisionPrimitive & c = object.mesh.getMeshVertex(clicked);
 
-                c->tag += 1;
+                c.tag += 1;
             }
         }
 
@@ -247,7 +247,7 @@ int main(int argc, char ** argv)
 
                 object.add
                 (
-                    std::make_shared<CollisionPrimitive>
+                    CollisionPrimitive
                     (
                         xm,
                         ym,
@@ -293,11 +293,11 @@ int main(int argc, char ** argv)
             int clicked = object.mesh.clicked(activeSite.first, activeSite.second);
             if (clicked != -1)
             {
-                auto c = object.mesh.getMeshVertex(clicked);
+                CollisionPrimitive & c = object.mesh.getMeshVertex(clicked);
 
                 jGLInstance->text
                 (
-                    "tag: " + std::to_string(c->tag),
+                    "tag: " + std::to_string(c.tag),
                     glm::vec2(resX*0.5f,resY-64.0f),
                     0.5f,
                     glm::vec4(0.0f,0.0f,0.0f, 1.0f),